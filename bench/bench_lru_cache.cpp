@@ -0,0 +1,48 @@
+#include "lru_cache.h"
+#include "benchmark.h"
+
+// Deterministic xorshift so runs are comparable; cheap enough (a few
+// shifts) that the cache dominates the measurement.
+static inline uint64_t nextRand(uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+// get() at a given hit percentage (the Arg): keys 0..cap-1 are resident,
+// misses probe keys beyond the capacity.
+static void BM_LRUCacheGet(bench::State& state) {
+    constexpr int CAP = 4096;
+    LRUCache<int, int> cache(CAP);
+    for (int i = 0; i < CAP; ++i) cache.put(int(i), i * 2);
+    const long hitPct = state.range(0);
+    uint64_t rng = 0x9e3779b97f4a7c15ull;
+    long consumed = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        const uint64_t r = nextRand(rng);
+        int key = static_cast<int>(r % CAP);
+        if (static_cast<long>(r % 100) >= hitPct) key += CAP; // force a miss
+        const int* v = cache.get(key);
+        if (v) consumed += *v;
+    }
+    if (consumed == -1) std::printf("unreachable\n"); // defeat dead-code elim
+}
+BENCHMARK(BM_LRUCacheGet)->Arg(100)->Arg(90)->Arg(50)->Arg(0);
+
+// put() over a key space twice the capacity: every second put displaces
+// the coldest entry, so this times insert + evict + recycle together.
+static void BM_LRUCachePut(bench::State& state) {
+    constexpr int CAP = 4096;
+    LRUCache<int, int> cache(CAP);
+    uint64_t rng = 0x2545f4914f6cdd1dull;
+    for ([[maybe_unused]] auto _ : state) {
+        const int key = static_cast<int>(nextRand(rng) % (2 * CAP));
+        cache.put(int(key), key);
+    }
+}
+BENCHMARK(BM_LRUCachePut);
+
+BENCHMARK_MAIN();
+
+// g++ -std=c++20 -O2 -pthread -I../cppExamples bench_lru_cache.cpp -o bench_lru_cache
@@ -0,0 +1,52 @@
+#include "median_stream.h"
+#include "benchmark.h"
+
+static inline uint64_t nextRand(uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+// Streaming insert cost. The finder is restarted every 1M elements so the
+// heaps stay a realistic size instead of growing monotonically with the
+// calibrated iteration count; the occasional restart amortizes to noise.
+static void BM_MedianFinderAddNum(bench::State& state) {
+    MedianFinder finder(1 << 20);
+    uint64_t rng = 0x853c49e6748fea9bull;
+    size_t sinceReset = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        finder.addNum(static_cast<int>(nextRand(rng) % 1000000));
+        if (++sinceReset == (1u << 20)) {
+            finder = MedianFinder(1 << 20);
+            sinceReset = 0;
+        }
+    }
+}
+BENCHMARK(BM_MedianFinderAddNum);
+
+static void BM_MedianFinderAddBatch1k(bench::State& state) {
+    std::vector<int> batch(1000);
+    uint64_t rng = 0xda3e39cb94b95bdbull;
+    for (int& v : batch) v = static_cast<int>(nextRand(rng) % 1000000);
+    for ([[maybe_unused]] auto _ : state) {
+        MedianFinder finder(1000);
+        finder.addBatch(batch.data(), batch.size());
+        if (finder.findMedian() < -1e18) std::printf("unreachable\n");
+    }
+}
+BENCHMARK(BM_MedianFinderAddBatch1k);
+
+// Sliding window: one insert + one expiry per op once the window fills.
+static void BM_SlidingMedianWindow1k(bench::State& state) {
+    SlidingMedianFinder finder(1000);
+    uint64_t rng = 0x94d049bb133111ebull;
+    for ([[maybe_unused]] auto _ : state) {
+        finder.addNum(static_cast<int>(nextRand(rng) % 1000000));
+    }
+}
+BENCHMARK(BM_SlidingMedianWindow1k);
+
+BENCHMARK_MAIN();
+
+// g++ -std=c++17 -O2 -I../cppExamples bench_median.cpp -o bench_median
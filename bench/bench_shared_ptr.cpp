@@ -0,0 +1,68 @@
+#include "my_shared_ptr.h"
+#include "benchmark.h"
+
+// Copy + destroy per op: two refcount bumps. The SingleThreaded policy
+// uses plain ints, ThreadSafe pays the atomics - the gap between these
+// two benchmarks is the price of the lock-free counter.
+static void BM_SharedPtrCopySingleThreaded(bench::State& state) {
+    SharedPtr<int> sp = MakeShared<int>(42);
+    for ([[maybe_unused]] auto _ : state) {
+        SharedPtr<int> copy(sp);
+        if (*copy != 42) std::printf("unreachable\n");
+    }
+}
+BENCHMARK(BM_SharedPtrCopySingleThreaded);
+
+static void BM_SharedPtrCopyThreadSafe(bench::State& state) {
+    SharedPtr<int, ThreadSafe> sp = MakeShared<int, ThreadSafe>(42);
+    for ([[maybe_unused]] auto _ : state) {
+        SharedPtr<int, ThreadSafe> copy(sp);
+        if (*copy != 42) std::printf("unreachable\n");
+    }
+}
+BENCHMARK(BM_SharedPtrCopyThreadSafe);
+
+// Move churn: ping-pong a pointer between two slots; no refcount traffic,
+// just pointer swaps - this should be within noise of raw assignment.
+static void BM_SharedPtrMove(bench::State& state) {
+    SharedPtr<int> a = MakeShared<int>(7);
+    SharedPtr<int> b;
+    for ([[maybe_unused]] auto _ : state) {
+        b = std::move(a);
+        a = std::move(b);
+    }
+}
+BENCHMARK(BM_SharedPtrMove);
+
+// Construction cost: MakeShared's single allocation vs the two separate
+// ones (object + control block) of the raw-pointer constructor.
+static void BM_MakeShared(bench::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        SharedPtr<int> sp = MakeShared<int>(1);
+        if (sp.use_count() == 0) std::printf("unreachable\n");
+    }
+}
+BENCHMARK(BM_MakeShared);
+
+static void BM_SharedPtrFromRaw(bench::State& state) {
+    for ([[maybe_unused]] auto _ : state) {
+        SharedPtr<int> sp(new int(1));
+        if (sp.use_count() == 0) std::printf("unreachable\n");
+    }
+}
+BENCHMARK(BM_SharedPtrFromRaw);
+
+// WeakPtr::lock: the CAS loop that only revives a live object.
+static void BM_WeakPtrLock(bench::State& state) {
+    SharedPtr<int, ThreadSafe> sp = MakeShared<int, ThreadSafe>(3);
+    WeakPtr<int, ThreadSafe> wp(sp);
+    for ([[maybe_unused]] auto _ : state) {
+        SharedPtr<int, ThreadSafe> locked = wp.lock();
+        if (locked.use_count() == 0) std::printf("unreachable\n");
+    }
+}
+BENCHMARK(BM_WeakPtrLock);
+
+BENCHMARK_MAIN();
+
+// g++ -std=c++17 -O2 -pthread -I../cppExamples bench_shared_ptr.cpp -o bench_shared_ptr
@@ -0,0 +1,148 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include <vector>
+
+/*
+ * Minimal google-benchmark-style harness, self-contained so the bench
+ * targets build with nothing but g++. Bench functions look like upstream
+ * google-benchmark:
+ *
+ *     static void BM_Thing(bench::State& state) {
+ *         for (auto _ : state) { ... one operation ... }
+ *     }
+ *     BENCHMARK(BM_Thing)->Arg(64)->Arg(1024);
+ *     BENCHMARK_MAIN();
+ *
+ * The runner calibrates the iteration count until a run takes long enough
+ * to time meaningfully, then reports ns/op and allocs/op. Allocation
+ * counting works by replacing global operator new/delete below - each
+ * bench executable is a single translation unit, so defining them here is
+ * fine.
+ */
+
+namespace bench {
+
+inline std::atomic<size_t> allocationCount{0};
+
+class State {
+public:
+    explicit State(size_t iterations, long arg) : iters(iterations), argValue(arg) {}
+
+    // Just enough iterator machinery for `for (auto _ : state)`.
+    struct iterator {
+        size_t remaining;
+        bool operator!=(const iterator& other) const { return remaining != other.remaining; }
+        void operator++() { --remaining; }
+        int operator*() const { return 0; }
+    };
+    iterator begin() const { return {iters}; }
+    iterator end() const { return {0}; }
+
+    size_t iterations() const { return iters; }
+    long range(size_t = 0) const { return argValue; }
+
+private:
+    size_t iters;
+    long argValue;
+};
+
+struct Benchmark {
+    const char* name;
+    void (*fn)(State&);
+    std::vector<long> args;
+
+    Benchmark* Arg(long value) {
+        args.push_back(value);
+        return this;
+    }
+};
+
+inline std::vector<Benchmark*>& registry() {
+    static std::vector<Benchmark*> list;
+    return list;
+}
+
+inline Benchmark* registerBenchmark(const char* name, void (*fn)(State&)) {
+    static std::deque<Benchmark> storage; // deque: stable addresses
+    storage.push_back(Benchmark{name, fn, {}});
+    registry().push_back(&storage.back());
+    return &storage.back();
+}
+
+inline void runOne(const Benchmark& b, long arg) {
+    using Clock = std::chrono::steady_clock;
+    size_t iters = 8;
+    for (;;) {
+        const size_t allocsBefore = allocationCount.load(std::memory_order_relaxed);
+        State state(iters, arg);
+        const auto start = Clock::now();
+        b.fn(state);
+        const auto elapsed = Clock::now() - start;
+        const size_t allocs = allocationCount.load(std::memory_order_relaxed) - allocsBefore;
+        const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        if (ns >= 100e6 || iters >= (1u << 24)) { // ~100ms is enough signal
+            char label[96];
+            if (b.args.empty()) std::snprintf(label, sizeof(label), "%s", b.name);
+            else std::snprintf(label, sizeof(label), "%s/%ld", b.name, arg);
+            std::printf("%-40s %12.1f ns/op %10.3f allocs/op %10zu iters\n",
+                        label, ns / static_cast<double>(iters),
+                        static_cast<double>(allocs) / static_cast<double>(iters), iters);
+            return;
+        }
+        // Scale toward the target time, at most 10x per step.
+        double scale = ns > 0 ? 120e6 / ns : 10.0;
+        if (scale > 10.0) scale = 10.0;
+        if (scale < 2.0) scale = 2.0;
+        iters = static_cast<size_t>(static_cast<double>(iters) * scale);
+    }
+}
+
+inline int runAll() {
+    for (Benchmark* b : registry()) {
+        if (b->args.empty()) {
+            runOne(*b, 0);
+        } else {
+            for (long arg : b->args) runOne(*b, arg);
+        }
+    }
+    return 0;
+}
+
+} // namespace bench
+
+#define BENCHMARK(fn) \
+    static ::bench::Benchmark* fn##_registration = ::bench::registerBenchmark(#fn, fn)
+
+#define BENCHMARK_MAIN() \
+    int main() { return ::bench::runAll(); }
+
+// Counting allocator hooks. Every operator new the examples use must be
+// covered (cyclic_queue.cpp allocates with std::align_val_t).
+void* operator new(std::size_t size) {
+    bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    bench::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(align);
+    const std::size_t padded = (size + a - 1) / a * a; // aligned_alloc wants a multiple
+    if (void* p = std::aligned_alloc(a, padded)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return ::operator new(size, align);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
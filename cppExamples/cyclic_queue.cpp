@@ -1,84 +1,4 @@
-#include <iostream>
-#include <list>
-#include <cassert>
-
-template <typename T>
-class CyclicQueue
-{
-public:
-    explicit CyclicQueue(size_t capacity): capacity(capacity), elements()
-    {   
-        std::cout << "CyclicQueue ctor: "  << capacity << "\n";    
-    }
-
-    ~CyclicQueue()
-    {
-        std::cout << "CyclicQueue dtor: " << "\n";    
-    }
-  
-    template<typename U> // we can not use template of the class since it would create Enqueue that aceepts only rvalues
-    void Enqueue(U&& val)
-    {
-        if(IsFull())
-        {
-            throw std::runtime_error("Queue is full, enqueue is prohibited");        
-        }
-        elements.emplace_back(std::forward<U>(val));
-        ++numElements;
-    }
-
-    T& GetOldest()
-    {
-        if(IsEmpty())
-        {
-            throw std::runtime_error("Queue is empty, GetOldest is prohibited");
-        }    
-        return elements.front();
-    }
-
-    const T& GetOldest() const
-    {
-        if(IsEmpty())
-        {
-            throw std::runtime_error("Queue is empty, GetOldest is prohibited");
-        }    
-        return elements.front();
-    }
-
-    void Dequeue()
-    {
-        if(IsEmpty())
-        {
-            throw std::runtime_error("Queue is empty, dequeue is prohibited");
-        }
-        elements.pop_front();
-        --numElements;
-    }
-
-    inline size_t Count() const
-    {
-        return numElements; 
-    }
-
-    inline bool IsFull() const 
-    {
-        return capacity == numElements;
-    }
-
-    inline bool IsEmpty() const 
-    {
-        return 0 == numElements;
-    }
-
-private:
-    CyclicQueue(const CyclicQueue&) = delete;
-    CyclicQueue(CyclicQueue&&) = delete;
-    CyclicQueue& operator=(const CyclicQueue&) = delete;
-    CyclicQueue& operator=(CyclicQueue&&) = delete;    
-    const size_t capacity;
-    size_t numElements = 0;
-    std::list<T> elements;
-};
+#include "cyclic_queue.h"
 
 ///////////////////////////////////////////////////////////////////////////
 // Movable-only class (deleted copy, default move)
@@ -87,11 +7,11 @@ class MovableOnly
 public:
     explicit MovableOnly(int v = 0) : p(new int(v)) 
     { 
-        std::cout << "MovableOnly ctor: " << v << "\n"; 
+        CYCLIC_QUEUE_TRACE_EVENT("MovableOnly ctor", v);
     }
     ~MovableOnly() 
     { 
-        std::cout << "MovableOnly dtor: " << (p ? *p : -1) << "\n"; 
+        CYCLIC_QUEUE_TRACE_EVENT("MovableOnly dtor", p ? *p : -1);
         delete p; 
     }
 
@@ -100,13 +20,13 @@ public:
 
     MovableOnly(MovableOnly&& other) noexcept : p(other.p) 
     { 
-        std::cout << "MovableOnly move ctor: " << (p ? *p : -1) << "\n"; 
+        CYCLIC_QUEUE_TRACE_EVENT("MovableOnly move ctor", p ? *p : -1);
         other.p = nullptr; 
     }
     MovableOnly& operator=(MovableOnly&& other) noexcept
     {
         if (this != &other) {
-            std::cout << "MovableOnly move assign: " << (other.p ? *other.p : -1) << "\n";
+            CYCLIC_QUEUE_TRACE_EVENT("MovableOnly move assign", other.p ? *other.p : -1);
             delete p;
             p = other.p;
             other.p = nullptr;
@@ -126,20 +46,20 @@ class CopyableNotMovable
 public:
     explicit CopyableNotMovable(int v = 0) : v_(v) 
     { 
-        std::cout << "CopyableNotMovable ctor: " << v << "\n"; 
+        CYCLIC_QUEUE_TRACE_EVENT("CopyableNotMovable ctor", v);
     }
     ~CopyableNotMovable() 
     { 
-        std::cout << "CopyableNotMovable dtor: " << v_ << "\n"; 
+        CYCLIC_QUEUE_TRACE_EVENT("CopyableNotMovable dtor", v_);
     }
 
     CopyableNotMovable(const CopyableNotMovable& other) : v_(other.v_)
     {
-        std::cout << "CopyableNotMovable copy ctor: " << v_ << "\n";
+        CYCLIC_QUEUE_TRACE_EVENT("CopyableNotMovable copy ctor", v_);
     }
     CopyableNotMovable& operator=(const CopyableNotMovable& other)
     {
-        std::cout << "CopyableNotMovable copy assign: " << other.v_ << "\n";
+        CYCLIC_QUEUE_TRACE_EVENT("CopyableNotMovable copy assign", other.v_);
         if (this != &other) {
             v_ = other.v_;
         }
@@ -181,9 +101,24 @@ void testMovableOnly()
 
 void testCopyableNotMovable()
 {
-    // CopyableNotMovable cannot be used with this queue because it has move deleted
-    // and the queue requires move assignment: arr[head] = std::move(val)
-    std::cout << "\n=== testCopyableNotMovable (skipped - requires move support) ===\n";
+    // With placement-new storage the queue only needs a constructor that
+    // matches the argument: an lvalue Enqueue copy-constructs in place.
+    std::cout << "\n=== testCopyableNotMovable ===\n";
+    CyclicQueue<CopyableNotMovable> q(2);
+
+    CopyableNotMovable x(1);
+    CopyableNotMovable y(2);
+    q.Enqueue(x);
+    q.Enqueue(y);
+    std::cout << "After enqueues - count: " << q.Count() << "\n";
+
+    auto a = q.GetOldest();
+    q.Dequeue();
+    std::cout << "Dequeued (copyable): " << a.value() << ", remaining count: " << q.Count() << "\n";
+
+    auto b = q.GetOldest();
+    q.Dequeue();
+    std::cout << "Dequeued (copyable): " << b.value() << ", remaining count: " << q.Count() << "\n";
 }
 
 void testCyclicQueueInt()
@@ -244,6 +179,138 @@ void testCyclicQueueWraparound()
     }
 }
 
+void testCyclicQueueBatch()
+{
+    std::cout << "\n=== testCyclicQueueBatch ===\n";
+    CyclicQueue<int> q(8);
+
+    // Partially fill and drain so the batch below straddles the wrap point.
+    q.Enqueue(0);
+    q.Enqueue(0);
+    int scratch[2];
+    assert(q.DequeueBatch(scratch, 2) == 2);
+
+    std::vector<int> burst = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    // Only 8 slots exist: the transfer is clipped to the free space.
+    assert(q.EnqueueBatch(burst.data(), burst.size()) == 8);
+    assert(q.IsFull());
+    assert(q.EnqueueBatch(burst.data(), burst.size()) == 0);
+
+    std::vector<int> drained;
+    assert(q.DequeueBatch(std::back_inserter(drained), 5) == 5);
+    assert(drained == (std::vector<int>{1, 2, 3, 4, 5}));
+    assert(q.Count() == 3);
+
+    // Iterator-range enqueue (non-pointer path) refills across the wrap.
+    assert(q.EnqueueBatch(burst.begin(), burst.begin() + 4) == 4);
+    int out[16];
+    assert(q.DequeueBatch(out, 16) == 7);
+    const int expected[] = {6, 7, 8, 1, 2, 3, 4};
+    for (int i = 0; i < 7; ++i) {
+        assert(out[i] == expected[i]);
+    }
+    assert(q.IsEmpty());
+    std::cout << "batch transfer across wraparound: PASSED\n";
+}
+
+void testSpscCyclicQueueStress()
+{
+    std::cout << "\n=== testSpscCyclicQueueStress (two threads) ===\n";
+    constexpr int numItems = 100000;
+    SpscCyclicQueue<int> q(8); // small ring forces constant wraparound
+
+    std::thread producer([&q]() {
+        for (int i = 0; i < numItems; ++i) {
+            while (!q.TryEnqueue(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Consumer runs on the test thread: values must come out in FIFO order.
+    int expected = 0;
+    while (expected < numItems) {
+        int val = -1;
+        if (q.TryDequeue(val)) {
+            assert(val == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    assert(q.IsEmpty());
+    std::cout << numItems << " items handed off in order: PASSED\n";
+}
+
+void testMpmcCyclicQueueWorkerPool()
+{
+    std::cout << "\n=== testMpmcCyclicQueueWorkerPool (4 producers / 4 consumers) ===\n";
+    constexpr int numProducers = 4;
+    constexpr int numConsumers = 4;
+    constexpr int itemsPerProducer = 10000;
+    MpmcCyclicQueue<int> q(16); // small ring keeps both wait paths exercised
+
+    std::atomic<long long> consumedSum{0};
+    std::atomic<int> consumedCount{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < numProducers; ++p) {
+        threads.emplace_back([&q, p]() {
+            for (int i = 0; i < itemsPerProducer; ++i) {
+                q.Enqueue(p * itemsPerProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < numConsumers; ++c) {
+        threads.emplace_back([&q, &consumedSum, &consumedCount]() {
+            int val = 0;
+            while (consumedCount.fetch_add(1) < numProducers * itemsPerProducer) {
+                q.Dequeue(val);
+                consumedSum.fetch_add(val);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    constexpr long long total = numProducers * itemsPerProducer;
+    assert(consumedSum.load() == total * (total - 1) / 2);
+    assert(q.IsEmpty());
+
+    // Timed wait on the now-empty queue must report a timeout, not block.
+    int val = -1;
+    assert(!q.TryDequeueFor(val, std::chrono::milliseconds(10)));
+    std::cout << total << " jobs fanned out, sum checks out: PASSED\n";
+}
+
+#if CYCLIC_QUEUE_TRACE
+namespace {
+long traceEventCount = 0;
+void countingTraceSink(const char*, long) { ++traceEventCount; }
+}
+
+void testTraceSink()
+{
+    // The sink is swappable at runtime: point it at a counter, make the
+    // queue churn a movable-only element, and every constructor/move/
+    // destructor event lands in the counter instead of on the console.
+    std::cout << "\n=== testTraceSink ===\n";
+    CyclicQueueTraceFn previous = cyclicQueueTraceSink();
+    cyclicQueueTraceSink() = countingTraceSink;
+    traceEventCount = 0;
+    {
+        CyclicQueue<MovableOnly> q(2);
+        q.Enqueue(MovableOnly(1)); // temp ctor + move into slot + temp dtor
+    } // queue dtor: stored element dtor + queue dtor event
+    cyclicQueueTraceSink() = previous;
+    assert(traceEventCount >= 5);
+    std::cout << "events routed through the custom sink: " << traceEventCount << ": PASSED\n";
+}
+#endif
+
 int main()
 {
     try {
@@ -251,6 +318,12 @@ int main()
         testCopyableNotMovable();
         testCyclicQueueInt();
         testCyclicQueueWraparound();
+        testCyclicQueueBatch();
+        testSpscCyclicQueueStress();
+        testMpmcCyclicQueueWorkerPool();
+#if CYCLIC_QUEUE_TRACE
+        testTraceSink();
+#endif
     }
     catch (const std::exception& ex) {
         std::cerr << "Exception: " << ex.what() << "\n";
@@ -259,4 +332,4 @@ int main()
     return 0;
 }
 
-// g++ -std=c++14 -Wall -Wextra -pedantic -Werror -Weffc++ -Woverloaded-virtual -Wctor-dtor-privacy -Wold-style-cast cyclic_queue.cpp -o cyclic_queue
+// g++ -std=c++17 -Wall -Wextra -pedantic -Werror -Weffc++ -Woverloaded-virtual -Wctor-dtor-privacy -Wold-style-cast -pthread -DCYCLIC_QUEUE_TRACE=1 cyclic_queue.cpp -o cyclic_queue
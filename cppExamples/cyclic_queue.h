@@ -0,0 +1,537 @@
+#pragma once
+#include <iostream>
+#include <new>
+#include <cassert>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// Compile-time tracing toggle (same switch style as LRU_CACHE_STATS in
+// lru_cache.h). With CYCLIC_QUEUE_TRACE=0 - the default - every trace
+// call expands to nothing: no iostream inside constructors, zero code in
+// production instantiations. With =1 events go through a replaceable
+// callback; the default callback writes to std::cout the way the old
+// unconditional prints did.
+#ifndef CYCLIC_QUEUE_TRACE
+#define CYCLIC_QUEUE_TRACE 0
+#endif
+
+#if CYCLIC_QUEUE_TRACE
+using CyclicQueueTraceFn = void (*)(const char* event, long value);
+
+inline void cyclicQueueTraceToCout(const char* event, long value)
+{
+    std::cout << event << ": " << value << "\n";
+}
+
+// The pluggable sink for instrumented builds. Swap it to capture events
+// in a test or route them into a logger instead of the console.
+inline CyclicQueueTraceFn& cyclicQueueTraceSink()
+{
+    static CyclicQueueTraceFn sink = cyclicQueueTraceToCout;
+    return sink;
+}
+
+#define CYCLIC_QUEUE_TRACE_EVENT(event, value) \
+    cyclicQueueTraceSink()(event, static_cast<long>(value))
+#else
+#define CYCLIC_QUEUE_TRACE_EVENT(event, value) ((void)0)
+#endif
+
+template <typename T>
+class CyclicQueue
+{
+public:
+    // Storage is one contiguous allocation done here - the hot path
+    // (Enqueue/Dequeue) never touches the allocator again.
+    explicit CyclicQueue(size_t capacity): capacity(capacity),
+        slots(static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T)))))
+    {
+        CYCLIC_QUEUE_TRACE_EVENT("CyclicQueue ctor", capacity);
+    }
+
+    ~CyclicQueue()
+    {
+        while(!IsEmpty())
+        {
+            Dequeue();
+        }
+        ::operator delete(slots, std::align_val_t(alignof(T)));
+        CYCLIC_QUEUE_TRACE_EVENT("CyclicQueue dtor", capacity);
+    }
+
+    template<typename U> // we can not use template of the class since it would create Enqueue that aceepts only rvalues
+    void Enqueue(U&& val)
+    {
+        if(IsFull())
+        {
+            throw std::runtime_error("Queue is full, enqueue is prohibited");
+        }
+        ::new(static_cast<void*>(slots + tail)) T(std::forward<U>(val));
+        tail = Next(tail);
+        ++numElements;
+    }
+
+    T& GetOldest()
+    {
+        if(IsEmpty())
+        {
+            throw std::runtime_error("Queue is empty, GetOldest is prohibited");
+        }
+        return slots[head];
+    }
+
+    const T& GetOldest() const
+    {
+        if(IsEmpty())
+        {
+            throw std::runtime_error("Queue is empty, GetOldest is prohibited");
+        }
+        return slots[head];
+    }
+
+    void Dequeue()
+    {
+        if(IsEmpty())
+        {
+            throw std::runtime_error("Queue is empty, dequeue is prohibited");
+        }
+        slots[head].~T();
+        head = Next(head);
+        --numElements;
+    }
+
+    // Batch API: bounds are validated once for the whole range instead of
+    // per element. Both calls transfer as much as fits/is available and
+    // return the count actually moved.
+    template<typename InputIt>
+    size_t EnqueueBatch(InputIt first, InputIt last)
+    {
+        const size_t requested = static_cast<size_t>(std::distance(first, last));
+        const size_t n = std::min(requested, capacity - numElements);
+        for(size_t i = 0; i < n; ++i, ++first)
+        {
+            ::new(static_cast<void*>(slots + tail)) T(std::move(*first));
+            tail = Next(tail);
+        }
+        numElements += n;
+        return n;
+    }
+
+    // Contiguous-source overload: trivially copyable types are copied with
+    // at most two memcpy calls (one per ring segment).
+    size_t EnqueueBatch(const T* data, size_t count)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            const size_t n = std::min(count, capacity - numElements);
+            const size_t firstChunk = std::min(n, capacity - tail);
+            std::memcpy(slots + tail, data, firstChunk * sizeof(T));
+            std::memcpy(slots, data + firstChunk, (n - firstChunk) * sizeof(T));
+            tail = (tail + n >= capacity) ? tail + n - capacity : tail + n;
+            numElements += n;
+            return n;
+        }
+        else
+        {
+            return EnqueueBatch(data, data + count);
+        }
+    }
+
+    template<typename OutputIt>
+    size_t DequeueBatch(OutputIt out, size_t maxCount)
+    {
+        const size_t n = std::min(maxCount, numElements);
+        for(size_t i = 0; i < n; ++i, ++out)
+        {
+            *out = std::move(slots[head]);
+            slots[head].~T();
+            head = Next(head);
+        }
+        numElements -= n;
+        return n;
+    }
+
+    size_t DequeueBatch(T* out, size_t maxCount)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            const size_t n = std::min(maxCount, numElements);
+            const size_t firstChunk = std::min(n, capacity - head);
+            std::memcpy(out, slots + head, firstChunk * sizeof(T));
+            std::memcpy(out + firstChunk, slots, (n - firstChunk) * sizeof(T));
+            head = (head + n >= capacity) ? head + n - capacity : head + n;
+            numElements -= n;
+            return n;
+        }
+        else
+        {
+            return DequeueBatch<T*>(out, maxCount);
+        }
+    }
+
+    inline size_t Count() const
+    {
+        return numElements;
+    }
+
+    inline bool IsFull() const
+    {
+        return capacity == numElements;
+    }
+
+    inline bool IsEmpty() const
+    {
+        return 0 == numElements;
+    }
+
+private:
+    CyclicQueue(const CyclicQueue&) = delete;
+    CyclicQueue(CyclicQueue&&) = delete;
+    CyclicQueue& operator=(const CyclicQueue&) = delete;
+    CyclicQueue& operator=(CyclicQueue&&) = delete;
+
+    inline size_t Next(size_t index) const
+    {
+        return (index + 1 == capacity) ? 0 : index + 1;
+    }
+
+    const size_t capacity;
+    size_t numElements = 0;
+    size_t head = 0; // next slot to dequeue
+    size_t tail = 0; // next slot to enqueue
+    T* slots;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// Single-producer/single-consumer variant: one thread may call TryEnqueue,
+// one other thread may call TryDequeue, with no external lock. head/tail
+// are atomics with acquire/release ordering and live on separate cache
+// lines so the producer and consumer don't false-share. The hot path never
+// throws - a full/empty queue is reported by the bool return instead.
+template <typename T>
+class SpscCyclicQueue
+{
+public:
+    // One extra slot distinguishes full from empty (head == tail is empty,
+    // Next(tail) == head is full), so no shared element counter is needed.
+    explicit SpscCyclicQueue(size_t capacity): capacity(capacity + 1),
+        slots(static_cast<T*>(::operator new((capacity + 1) * sizeof(T), std::align_val_t(alignof(T)))))
+    {
+    }
+
+    ~SpscCyclicQueue()
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        const size_t t = tail.load(std::memory_order_relaxed);
+        while(h != t)
+        {
+            slots[h].~T();
+            h = Next(h);
+        }
+        ::operator delete(slots, std::align_val_t(alignof(T)));
+    }
+
+    template<typename U>
+    bool TryEnqueue(U&& val)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t nextTail = Next(t);
+        if(nextTail == head.load(std::memory_order_acquire))
+        {
+            return false; // full
+        }
+        ::new(static_cast<void*>(slots + t)) T(std::forward<U>(val));
+        tail.store(nextTail, std::memory_order_release); // publish to consumer
+        return true;
+    }
+
+    bool TryDequeue(T& out)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(h == tail.load(std::memory_order_acquire))
+        {
+            return false; // empty
+        }
+        out = std::move(slots[h]);
+        slots[h].~T();
+        head.store(Next(h), std::memory_order_release); // release slot to producer
+        return true;
+    }
+
+    // Count is a snapshot - it can be stale by the time the caller uses it,
+    // which is inherent to any concurrent queue.
+    inline size_t Count() const
+    {
+        const size_t h = head.load(std::memory_order_acquire);
+        const size_t t = tail.load(std::memory_order_acquire);
+        return (t >= h) ? t - h : capacity - h + t;
+    }
+
+    inline bool IsEmpty() const
+    {
+        return 0 == Count();
+    }
+
+    inline bool IsFull() const
+    {
+        return capacity - 1 == Count();
+    }
+
+private:
+    SpscCyclicQueue(const SpscCyclicQueue&) = delete;
+    SpscCyclicQueue(SpscCyclicQueue&&) = delete;
+    SpscCyclicQueue& operator=(const SpscCyclicQueue&) = delete;
+    SpscCyclicQueue& operator=(SpscCyclicQueue&&) = delete;
+
+    inline size_t Next(size_t index) const
+    {
+        return (index + 1 == capacity) ? 0 : index + 1;
+    }
+
+    const size_t capacity; // ring size, one more than usable capacity
+    T* slots;
+    alignas(64) std::atomic<size_t> head{0}; // consumer side
+    alignas(64) std::atomic<size_t> tail{0}; // producer side
+};
+
+///////////////////////////////////////////////////////////////////////////
+// Multi-producer/multi-consumer work queue. Each slot carries a sequence
+// number (Vyukov-style): a producer claims a slot by CAS on tail when the
+// slot's sequence says it is free, a consumer when it says it is filled, so
+// the fast path is a single CAS with no lock. Blocking Enqueue/Dequeue and
+// the timed TryDequeueFor fall back to a condition variable, which is only
+// touched when someone actually has to wait.
+template <typename T>
+class MpmcCyclicQueue
+{
+public:
+    explicit MpmcCyclicQueue(size_t capacity): capacity(capacity), slots(new Slot[capacity])
+    {
+        for(size_t i = 0; i < capacity; ++i)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcCyclicQueue()
+    {
+        // Single-threaded by now: destroy whatever is still enqueued.
+        for(size_t pos = head.load(std::memory_order_relaxed);
+            pos != tail.load(std::memory_order_relaxed); ++pos)
+        {
+            Slot& slot = slots[pos % capacity];
+            if(slot.sequence.load(std::memory_order_relaxed) == pos + 1)
+            {
+                ValuePtr(slot)->~T();
+            }
+        }
+        delete[] slots;
+    }
+
+    template<typename U>
+    bool TryEnqueue(U&& val)
+    {
+        if(!TryEnqueueNoWake(std::forward<U>(val)))
+        {
+            return false;
+        }
+        WakeConsumer();
+        return true;
+    }
+
+    bool TryDequeue(T& out)
+    {
+        if(!TryDequeueNoWake(out))
+        {
+            return false;
+        }
+        WakeProducer();
+        return true;
+    }
+
+    template<typename U>
+    void Enqueue(U&& val)
+    {
+        if(TryEnqueue(std::forward<U>(val)))
+        {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            ++waitingProducers;
+            notFull.wait(lock, [&]{ return TryEnqueueNoWake(std::forward<U>(val)); });
+            --waitingProducers;
+        }
+        WakeConsumer();
+    }
+
+    void Dequeue(T& out)
+    {
+        if(TryDequeue(out))
+        {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            ++waitingConsumers;
+            notEmpty.wait(lock, [&]{ return TryDequeueNoWake(out); });
+            --waitingConsumers;
+        }
+        WakeProducer();
+    }
+
+    template<typename Rep, typename Period>
+    bool TryDequeueFor(T& out, std::chrono::duration<Rep, Period> timeout)
+    {
+        if(TryDequeue(out))
+        {
+            return true;
+        }
+        bool got = false;
+        {
+            std::unique_lock<std::mutex> lock(waitMutex);
+            ++waitingConsumers;
+            got = notEmpty.wait_for(lock, timeout, [&]{ return TryDequeueNoWake(out); });
+            --waitingConsumers;
+        }
+        if(got)
+        {
+            WakeProducer();
+        }
+        return got;
+    }
+
+    // Snapshots, same caveat as SpscCyclicQueue::Count.
+    inline size_t Count() const
+    {
+        const size_t t = tail.load(std::memory_order_acquire);
+        const size_t h = head.load(std::memory_order_acquire);
+        return (t >= h) ? t - h : 0;
+    }
+
+    inline bool IsEmpty() const
+    {
+        return 0 == Count();
+    }
+
+    inline bool IsFull() const
+    {
+        return capacity == Count();
+    }
+
+private:
+    MpmcCyclicQueue(const MpmcCyclicQueue&) = delete;
+    MpmcCyclicQueue(MpmcCyclicQueue&&) = delete;
+    MpmcCyclicQueue& operator=(const MpmcCyclicQueue&) = delete;
+    MpmcCyclicQueue& operator=(MpmcCyclicQueue&&) = delete;
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};
+        alignas(alignof(T)) unsigned char storage[sizeof(T)] = {};
+    };
+
+    static T* ValuePtr(Slot& slot)
+    {
+        return reinterpret_cast<T*>(slot.storage);
+    }
+
+    // Lock-free cores. They must not touch waitMutex: the blocking calls
+    // run them as condition-variable predicates while holding it.
+    template<typename U>
+    bool TryEnqueueNoWake(U&& val)
+    {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            Slot& slot = slots[pos % capacity];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            if(seq == pos) // slot is free for this ticket
+            {
+                if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    ::new(static_cast<void*>(ValuePtr(slot))) T(std::forward<U>(val));
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // lost the CAS race, pos was reloaded - retry
+            }
+            else if(seq < pos)
+            {
+                return false; // full: slot not yet consumed from the previous lap
+            }
+            else
+            {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryDequeueNoWake(T& out)
+    {
+        size_t pos = head.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            Slot& slot = slots[pos % capacity];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            if(seq == pos + 1) // slot is filled for this ticket
+            {
+                if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    out = std::move(*ValuePtr(slot));
+                    ValuePtr(slot)->~T();
+                    slot.sequence.store(pos + capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(seq < pos + 1)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Waiter counters let the lock-free fast path skip the mutex entirely
+    // unless a thread is actually parked. A waiter increments its counter
+    // and re-checks the predicate under the lock before sleeping, so a wake
+    // that races with registration cannot be lost.
+    void WakeConsumer()
+    {
+        if(waitingConsumers.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(waitMutex);
+            notEmpty.notify_one();
+        }
+    }
+
+    void WakeProducer()
+    {
+        if(waitingProducers.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(waitMutex);
+            notFull.notify_one();
+        }
+    }
+
+    const size_t capacity;
+    Slot* slots;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<size_t> waitingProducers{0};
+    std::atomic<size_t> waitingConsumers{0};
+    std::mutex waitMutex{};
+    std::condition_variable notEmpty{};
+    std::condition_variable notFull{};
+};
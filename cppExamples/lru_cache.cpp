@@ -1,95 +1,251 @@
-#include <iostream>
-#include <unordered_map>
-#include <list>
-#include <cassert>
-using namespace std;
-
-/**
- * Task: Implement an LRU Cache with capacity 'cap'.
- * Requirement: O(1) time complexity for both get and put.
- */
-class LRUCache {
-    struct Node {
-        int key;
-        int val;
-    };
-    list<Node> priorityQ;
-    unordered_map<int, list<Node>::iterator > keyToNode;
-    const int capacity;
-
-public:
-    LRUCache(int _capacity):capacity(_capacity)
-    {
-    }
-    
-    int get(int key) 
-    {
-        auto kToNode = keyToNode.find(key);
-        if( kToNode == keyToNode.end() ) 
-        {
-            return -1;
-        }
-
-        int valToReturn = kToNode->second->val;
-        priorityQ.erase(kToNode->second);
-        keyToNode.erase(kToNode);
-        priorityQ.push_back({.key=key, .val=valToReturn});
-        keyToNode.insert({key, prev(priorityQ.end())});        
-        return valToReturn;
-    }
-    
-    void put(int key, int value) 
-    {      
-        auto kToNode = keyToNode.find(key);
-        bool keyExist = kToNode != keyToNode.end();
-        
-        if(capacity == keyToNode.size() and !keyExist)
-        {           
-            int keyToEvict = priorityQ.front().key;
-            keyToNode.erase(keyToNode.find(keyToEvict));
-            priorityQ.pop_front();
-        }
-        
-        if(keyExist)
-        {
-            priorityQ.erase(kToNode->second);
-            keyToNode.erase(kToNode);
-        }
-        
-        priorityQ.push_back({.key=key, .val=value});
-        keyToNode.insert({key, prev(priorityQ.end())});
-    }
-};
+#include "lru_cache.h"
+using namespace std; // test driver only - the header stays clean
 
 void test_lru() {
-    LRUCache cache(2);
+    LRUCache<int, int> cache(2);
 
     cout << "Test 1: Basic Put & Get: ";
     cache.put(1, 10);
     cache.put(2, 20);
-    if (cache.get(1) == 10) cout << "Pass\n";
-    else cout << "FAIL (Expected 10, got " << cache.get(1) << ")\n";
+    int* v1 = cache.get(1);
+    if (v1 && *v1 == 10) cout << "Pass\n";
+    else cout << "FAIL (Expected 10)\n";
 
     cout << "Test 2: Eviction Logic: ";
     cache.put(3, 30); // Should evict 2 (if LRU works correctly)
-    if (cache.get(2) == -1) cout << "Pass\n";
+    if (cache.get(2) == nullptr) cout << "Pass\n";
     else cout << "FAIL (Key 2 should have been evicted)\n";
 
     cout << "Test 3: Access updates LRU order: ";
     cache.get(1);     // 1 becomes MRU
     cache.put(4, 40); // Should evict 3 now
-    if (cache.get(3) == -1) cout << "Pass\n";
+    if (cache.get(3) == nullptr) cout << "Pass\n";
     else cout << "FAIL (Key 3 should have been evicted because 1 was accessed)\n";
 
     cout << "Test 4: Handle updates: ";
     cache.put(4, 44);
-    if (cache.get(4) == 44) cout << "Pass\n";
-    else cout << "FAIL (Expected updated value 44, got " << cache.get(4) << ")\n";
+    int* v4 = cache.get(4);
+    if (v4 && *v4 == 44) cout << "Pass\n";
+    else cout << "FAIL (Expected updated value 44)\n";
+}
+
+void test_lru_ttl() {
+    cout << "Test 8: TTL lazy expiry in get: ";
+    LRUCache<int, int> cache(4);
+    cache.put(1, 10, chrono::milliseconds(30));
+    cache.put(2, 20); // no TTL, never expires
+    int* v1 = cache.get(1);
+    bool ok = v1 && *v1 == 10;
+    this_thread::sleep_for(chrono::milliseconds(60));
+    ok = ok && cache.get(1) == nullptr && cache.get(2) != nullptr;
+    if (ok) cout << "Pass\n";
+    else cout << "FAIL (TTL expiry broken)\n";
+
+    cout << "Test 9: Expired entries don't pin capacity: ";
+    LRUCache<int, int> small(2);
+    small.put(1, 10, chrono::milliseconds(20));
+    this_thread::sleep_for(chrono::milliseconds(50));
+    // The sweep inside put reclaims slot 1, so 2 and 3 both fit without
+    // 3 having to evict 2.
+    small.put(2, 20);
+    small.put(3, 30);
+    if (small.get(2) && small.get(3)) cout << "Pass\n";
+    else cout << "FAIL (expired entry displaced a live one)\n";
+}
+
+void test_lru_heterogeneous() {
+    cout << "Test 7: String keys with string_view lookup: ";
+    LRUCache<string, string, StringHash> cache(2);
+    cache.put("alpha", "A");
+    cache.put("beta", "B");
+
+    // Probing with a string_view: no std::string temporary is built.
+    string_view probe = "alpha";
+    string* v = cache.get(probe);
+    bool ok = v && *v == "A";
+
+    cache.put("gamma", "C"); // evicts "beta" (alpha was just touched)
+    ok = ok && cache.get(string_view("beta")) == nullptr && cache.get("gamma");
+    if (ok) cout << "Pass\n";
+    else cout << "FAIL (heterogeneous lookup broken)\n";
+}
+
+void test_sharded_lru() {
+    cout << "Test 5: Sharded basic semantics: ";
+    ShardedLRUCache cache(64, 4);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    if (cache.get(1) == 10 && cache.get(2) == 20 && cache.get(3) == -1) cout << "Pass\n";
+    else cout << "FAIL (sharded get/put broken)\n";
+
+    cout << "Test 6: Sharded concurrent access: ";
+    ShardedLRUCache shared(1024, 8);
+    vector<thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&shared, t]() {
+            // Each thread owns a disjoint key range: its values must survive.
+            for (int i = 0; i < 100; ++i) {
+                shared.put(t * 100 + i, t * 100 + i);
+            }
+            for (int i = 0; i < 100; ++i) {
+                shared.get(t * 100 + i);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool ok = true;
+    for (int k = 0; k < 800; ++k) {
+        if (shared.get(k) != k) { ok = false; break; }
+    }
+    if (ok) cout << "Pass\n";
+    else cout << "FAIL (lost writes under concurrency)\n";
+}
+
+void test_lru_eviction_callback() {
+    cout << "Test 10: Eviction callback fires on displacement: ";
+    LRUCache<int, int> cache(2);
+    vector<pair<int, int>> evicted;
+    cache.onEvict([&evicted](int&& k, int&& v) { evicted.emplace_back(k, v); });
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30); // displaces 1
+    if (evicted.size() == 1 && evicted[0] == make_pair(1, 10)) cout << "Pass\n";
+    else cout << "FAIL (callback missed the evicted entry)\n";
+
+    cout << "Test 11: evictBatch drains coldest first: ";
+    LRUCache<int, int> buffer(4);
+    for (int k = 1; k <= 4; ++k) buffer.put(k, k * 10);
+    auto drained = buffer.evictBatch(3);
+    bool ok = drained.size() == 3;
+    for (int i = 0; i < 3 && ok; ++i) {
+        ok = drained[i] == make_pair(i + 1, (i + 1) * 10);
+    }
+    ok = ok && buffer.get(1) == nullptr && buffer.get(4) != nullptr;
+    if (ok) cout << "Pass\n";
+    else cout << "FAIL (batch eviction order or contents wrong)\n";
+}
+
+void test_lru_stats() {
+#if LRU_CACHE_STATS
+    cout << "Test 12: Stats snapshot: ";
+    LRUCache<int, int> cache(2);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.get(1);      // hit
+    cache.get(7);      // miss
+    cache.put(3, 30);  // evicts 2
+    auto stats = cache.snapshot();
+    bool ok = stats.hits == 1 && stats.misses == 1 && stats.evictions == 1
+           && stats.occupancy == 2 && stats.capacity == 2;
+    if (ok) cout << "Pass\n";
+    else cout << "FAIL (hits=" << stats.hits << " misses=" << stats.misses
+              << " evictions=" << stats.evictions << ")\n";
+#else
+    cout << "Test 12: Stats snapshot: skipped (stats compiled out)\n";
+#endif
+}
+
+void test_lru_index_churn() {
+    cout << "Test 13: Flat index survives heavy eviction churn: ";
+    LRUCache<int, int> cache(100);
+    // 10k sequential puts force ~9900 evictions, so the open-addressing
+    // table accumulates tombstones and rebuilds itself several times.
+    for (int k = 0; k < 10000; ++k) {
+        cache.put(k, k + 1);
+    }
+    bool ok = true;
+    for (int k = 9900; k < 10000 && ok; ++k) {
+        int* v = cache.get(k);
+        ok = v && *v == k + 1;
+    }
+    for (int k = 0; k < 100 && ok; ++k) {
+        ok = cache.get(k) == nullptr;
+    }
+    if (ok) cout << "Pass\n";
+    else cout << "FAIL (index corrupted by tombstone churn)\n";
+}
+
+void test_lru_clock_mode() {
+    using Mode = LRUCache<int, int>::EvictionMode;
+
+    cout << "Test 14: Clock mode gives hit entries a second chance: ";
+    LRUCache<int, int> cache(3, Mode::Clock);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    assert(*cache.get(1) == 10); // sets 1's reference bit
+    cache.put(4, 40);            // hand skips 1, evicts 2 (oldest unreferenced)
+    assert(cache.get(2) == nullptr);
+    assert(*cache.get(1) == 10);
+    assert(*cache.get(3) == 30);
+    assert(*cache.get(4) == 40);
+    cout << "Pass\n";
+
+    cout << "Test 15: Clock mode keeps a constantly-hit key alive under churn: ";
+    LRUCache<int, int> churn(3, Mode::Clock);
+    churn.put(0, 0);
+    for (int i = 1; i <= 200; ++i) {
+        assert(churn.get(0) != nullptr); // re-arms 0's bit every round
+        churn.put(i, i);
+    }
+    assert(*churn.get(0) == 0);
+    assert(churn.snapshot().occupancy == 3);
+    cout << "Pass\n";
+}
+
+void test_lru_snapshot() {
+    cout << "Test 16: Snapshot restores entries and exact recency order: ";
+    LRUCache<int, int> cache(4);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    cache.put(4, 40);
+    assert(*cache.get(2) == 20); // recency now (coldest first): 1, 3, 4, 2
+    cache.saveTo("lru_snapshot.bin");
+
+    LRUCache<int, int> restored(4);
+    restored.loadFrom("lru_snapshot.bin");
+    for (int key = 1; key <= 4; ++key) {
+        int* v = restored.get(key);
+        assert(v != nullptr && *v == key * 10);
+    }
+    // get() above re-touched everything; reload once more to check the
+    // order alone: the next eviction must hit 1, the saved coldest entry.
+    LRUCache<int, int> ordered(4);
+    ordered.loadFrom("lru_snapshot.bin");
+    ordered.put(5, 50);
+    assert(ordered.get(1) == nullptr);
+    assert(*ordered.get(3) == 30 && *ordered.get(4) == 40 && *ordered.get(2) == 20);
+    cout << "Pass\n";
+
+    cout << "Test 17: Snapshot keeps remaining TTLs ticking: ";
+    LRUCache<int, int> ttlCache(2);
+    ttlCache.put(1, 11, chrono::milliseconds(80));
+    ttlCache.put(2, 22);
+    ttlCache.saveTo("lru_snapshot.bin");
+
+    LRUCache<int, int> ttlRestored(2);
+    ttlRestored.loadFrom("lru_snapshot.bin");
+    assert(*ttlRestored.get(1) == 11); // still inside the original 80ms
+    this_thread::sleep_for(chrono::milliseconds(100));
+    assert(ttlRestored.get(1) == nullptr); // expired on the restored clock
+    assert(*ttlRestored.get(2) == 22);
+    remove("lru_snapshot.bin");
+    cout << "Pass\n";
 }
 
 int main() {
     try {
         test_lru();
+        test_sharded_lru();
+        test_lru_heterogeneous();
+        test_lru_ttl();
+        test_lru_eviction_callback();
+        test_lru_stats();
+        test_lru_index_churn();
+        test_lru_clock_mode();
+        test_lru_snapshot();
     } catch (const exception& e) {
         cerr << "Crashed with exception: " << e.what() << endl;
     } catch (...) {
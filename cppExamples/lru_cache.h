@@ -0,0 +1,530 @@
+#pragma once
+#include <iostream>
+#include <list>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Compile-time stats toggle: build with -DLRU_CACHE_STATS=0 and the
+// counters, their memory and their increments vanish entirely from the
+// hot path. When enabled the counters are relaxed atomics, so reading a
+// snapshot from a metrics thread doesn't need the cache's lock.
+#ifndef LRU_CACHE_STATS
+#define LRU_CACHE_STATS 1
+#endif
+
+struct LRUCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0; // capacity displacement + TTL reclamation
+    size_t occupancy = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * Task: Implement an LRU Cache with capacity 'cap'.
+ * Requirement: O(1) time complexity for both get and put.
+ *
+ * Storage is a node pool preallocated to 'capacity': the recency list is
+ * intrusive (prev/next indices inside each pooled node) and evicted nodes
+ * are recycled through a free list, so steady-state get/put never touch
+ * the allocator. Lookup goes through a flat open-addressing index of
+ * (hash, slot) pairs rather than an unordered_map, so a hit touches one
+ * or two cache lines of the index plus the node itself.
+ *
+ * Key/Value/Hash are template parameters. get() hands back a non-owning
+ * pointer (nullptr on miss) so large values aren't copied out, and a
+ * transparent Hash (one with is_transparent, e.g. StringHash below) lets
+ * callers probe e.g. a string-keyed cache with a string_view without
+ * materializing a temporary key.
+ *
+ * Entries may carry a TTL (third argument to put). Expiry is lazy - get()
+ * treats a stale hit as a miss and frees the node - plus an incremental
+ * sweep: every put also inspects a couple of slots past a roving cursor,
+ * so expired entries are reclaimed in O(1) amortized steps and don't pin
+ * capacity that live entries could use.
+ *
+ * Eviction order is strict LRU by default. For read-heavy workloads the
+ * Clock (second-chance) mode makes a hit a single byte store into a flat
+ * reference array instead of a four-pointer list splice; the recency
+ * bookkeeping moves to eviction time, where the clock hand rotates past
+ * referenced entries (clearing their bits) until it finds a victim.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+    enum class EvictionMode { LRU, Clock };
+
+private:
+    static constexpr int NIL = -1;
+    using Clock = std::chrono::steady_clock;
+    struct Node {
+        Key key;
+        Value val;
+        int prev;
+        int next;
+        Clock::time_point expiresAt;
+        bool live; // false while the node sits on the free list
+    };
+    std::vector<Node> pool;
+
+    // Flat open-addressing index (linear probing, power-of-two table kept
+    // at most half full). Entries hold the key's hash and the pool slot -
+    // the key itself stays in the pooled node, so a probe touches one
+    // contiguous array and only dereferences into the pool on a hash
+    // match. Deletions leave tombstones; the table is rebuilt when
+    // occupied + tombstones pass 3/4 of the table.
+    static constexpr int EMPTY = -1;
+    static constexpr int TOMB = -2;
+    struct IndexEntry {
+        size_t hash;
+        int slot;
+    };
+    std::vector<IndexEntry> index;
+    size_t indexMask = 0;
+    int numEntries = 0;
+    int numTombstones = 0;
+    Hash hasher;
+
+    template <typename K>
+    int indexFind(const K& key, size_t h) const
+    {
+        for (size_t pos = h & indexMask;; pos = (pos + 1) & indexMask) {
+            const IndexEntry& e = index[pos];
+            if (e.slot == EMPTY) return NIL;
+            if (e.slot != TOMB && e.hash == h && pool[e.slot].key == key) return e.slot;
+        }
+    }
+
+    void indexInsert(int slot, size_t h)
+    {
+        if (4 * (numEntries + numTombstones + 1) > 3 * static_cast<int>(index.size())) {
+            indexRebuild();
+        }
+        for (size_t pos = h & indexMask;; pos = (pos + 1) & indexMask) {
+            if (index[pos].slot == EMPTY || index[pos].slot == TOMB) {
+                if (index[pos].slot == TOMB) --numTombstones;
+                index[pos] = {h, slot};
+                ++numEntries;
+                return;
+            }
+        }
+    }
+
+    template <typename K>
+    void indexErase(const K& key, size_t h)
+    {
+        for (size_t pos = h & indexMask;; pos = (pos + 1) & indexMask) {
+            IndexEntry& e = index[pos];
+            if (e.slot == EMPTY) return;
+            if (e.slot != TOMB && e.hash == h && pool[e.slot].key == key) {
+                e.slot = TOMB;
+                --numEntries;
+                ++numTombstones;
+                return;
+            }
+        }
+    }
+
+    // Same table size, tombstones dropped: live entries can never exceed
+    // half the table, so an EMPTY slot always remains for probes to stop at.
+    void indexRebuild()
+    {
+        std::vector<IndexEntry> old;
+        old.swap(index);
+        index.assign(old.size(), {0, EMPTY});
+        numEntries = 0;
+        numTombstones = 0;
+        for (const IndexEntry& e : old) {
+            if (e.slot >= 0) indexInsert(e.slot, e.hash);
+        }
+    }
+
+    int lruIdx = NIL;  // coldest entry, evicted first
+    int mruIdx = NIL;  // hottest entry
+    int freeIdx = NIL; // head of the recycled-node free list
+    int sweepCursor = 0;
+    const int capacity;
+    const EvictionMode mode;
+    // One byte per slot (a packed bitset would share bytes between slots,
+    // which a future concurrent version couldn't store into blindly).
+    // Only consulted in Clock mode.
+    std::vector<uint8_t> refBits;
+    std::function<void(Key&&, Value&&)> evictCb;
+
+#if LRU_CACHE_STATS
+    mutable std::atomic<uint64_t> hitCount{0};
+    mutable std::atomic<uint64_t> missCount{0};
+    mutable std::atomic<uint64_t> evictionCount{0};
+#endif
+
+    void countHit() const
+    {
+#if LRU_CACHE_STATS
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    void countMiss() const
+    {
+#if LRU_CACHE_STATS
+        missCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    void countEviction() const
+    {
+#if LRU_CACHE_STATS
+        evictionCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    void detach(int idx)
+    {
+        Node& n = pool[idx];
+        if (n.prev != NIL) pool[n.prev].next = n.next;
+        else lruIdx = n.next;
+        if (n.next != NIL) pool[n.next].prev = n.prev;
+        else mruIdx = n.prev;
+    }
+
+    void attachAsMru(int idx)
+    {
+        Node& n = pool[idx];
+        n.prev = mruIdx;
+        n.next = NIL;
+        if (mruIdx != NIL) pool[mruIdx].next = idx;
+        mruIdx = idx;
+        if (lruIdx == NIL) lruIdx = idx;
+    }
+
+    void freeNode(int idx)
+    {
+        detach(idx);
+        pool[idx].next = freeIdx; // reuse 'next' as the free-list link
+        pool[idx].live = false;
+        freeIdx = idx;
+    }
+
+    void removeSlot(int idx)
+    {
+        indexErase(pool[idx].key, hasher(pool[idx].key));
+        if (evictCb) evictCb(std::move(pool[idx].key), std::move(pool[idx].val));
+        freeNode(idx);
+        countEviction();
+    }
+
+    static bool expired(const Node& n, Clock::time_point now)
+    {
+        return n.expiresAt <= now;
+    }
+
+    // Amortized reclamation: look at a couple of slots past a roving
+    // cursor and free any that have expired.
+    void sweepSome(Clock::time_point now)
+    {
+        for (int step = 0; step < 2 && !pool.empty(); ++step) {
+            sweepCursor = (sweepCursor + 1) % static_cast<int>(pool.size());
+            if (pool[sweepCursor].live && expired(pool[sweepCursor], now)) {
+                removeSlot(sweepCursor);
+            }
+        }
+    }
+
+    // A hit in LRU mode splices the node to the MRU end of the list; in
+    // Clock mode it is one byte store and nothing else.
+    void touch(int idx)
+    {
+        if (mode == EvictionMode::Clock) {
+            refBits[idx] = 1;
+        } else {
+            detach(idx);
+            attachAsMru(idx);
+        }
+    }
+
+    // LRU evicts the list head outright. Clock gives referenced entries a
+    // second chance: the hand (the list head) clears the bit and rotates
+    // the node to the tail until it lands on an unreferenced entry.
+    // Terminates because every rotation clears a bit.
+    int chooseVictim()
+    {
+        if (mode == EvictionMode::Clock) {
+            while (refBits[lruIdx]) {
+                refBits[lruIdx] = 0;
+                const int hand = lruIdx;
+                detach(hand);
+                attachAsMru(hand);
+            }
+        }
+        return lruIdx;
+    }
+
+public:
+    LRUCache(int _capacity, EvictionMode _mode = EvictionMode::LRU)
+        : pool(), index(), hasher(), capacity(_capacity), mode(_mode), refBits()
+    {
+        pool.reserve(capacity);
+        refBits.assign(capacity, 0);
+        size_t tableSize = 8;
+        while (tableSize < 2 * static_cast<size_t>(capacity)) tableSize <<= 1;
+        index.assign(tableSize, {0, EMPTY});
+        indexMask = tableSize - 1;
+    }
+
+    template <typename K>
+    Value* get(const K& key)
+    {
+        const int idx = indexFind(key, hasher(key));
+        if( idx == NIL )
+        {
+            countMiss();
+            return nullptr;
+        }
+        if (expired(pool[idx], Clock::now()))
+        {
+            removeSlot(idx); // lazy expiry: a stale hit is a miss
+            countMiss();
+            return nullptr;
+        }
+
+        touch(idx);
+        countHit();
+        return &pool[idx].val;
+    }
+
+    // ttl of zero (the default) means the entry never expires.
+    template <typename K, typename V>
+    void put(K&& key, V&& value, Clock::duration ttl = Clock::duration::zero())
+    {
+        const auto now = Clock::now();
+        sweepSome(now);
+        const auto expiresAt = (ttl == Clock::duration::zero())
+            ? Clock::time_point::max() : now + ttl;
+
+        const size_t h = hasher(key);
+        const int existing = indexFind(key, h);
+        if (existing != NIL)
+        {
+            pool[existing].val = std::forward<V>(value);
+            pool[existing].expiresAt = expiresAt;
+            touch(existing);
+            return;
+        }
+
+        int idx;
+        if (static_cast<int>(pool.size()) < capacity)
+        {
+            // Still warming up: carve a fresh node from the pool.
+            idx = static_cast<int>(pool.size());
+            pool.push_back({Key(std::forward<K>(key)), Value(std::forward<V>(value)), NIL, NIL, expiresAt, true});
+        }
+        else
+        {
+            if (freeIdx != NIL)
+            {
+                idx = freeIdx;
+                freeIdx = pool[idx].next;
+            }
+            else
+            {
+                // Full: pick a victim, evict it and recycle its node.
+                idx = chooseVictim();
+                indexErase(pool[idx].key, hasher(pool[idx].key));
+                if (evictCb) evictCb(std::move(pool[idx].key), std::move(pool[idx].val));
+                detach(idx);
+                countEviction();
+            }
+            pool[idx].key = Key(std::forward<K>(key));
+            pool[idx].val = Value(std::forward<V>(value));
+            pool[idx].expiresAt = expiresAt;
+            pool[idx].live = true;
+        }
+
+        attachAsMru(idx);
+        refBits[idx] = 0; // entries start unreferenced; only a hit protects them
+        indexInsert(idx, h);
+    }
+
+    // Called with (key, value) moved out of every entry the cache drops on
+    // its own - capacity eviction or TTL expiry. Not called by evictBatch,
+    // whose caller receives the entries directly.
+    using EvictionCallback = std::function<void(Key&&, Value&&)>;
+    void onEvict(EvictionCallback cb)
+    {
+        evictCb = std::move(cb);
+    }
+
+    // Pops up to n of the coldest entries in one pass and hands them out
+    // by move, coldest first - lets a write-back user coalesce them into
+    // a single bulk write instead of one I/O per displaced key.
+    std::vector<std::pair<Key, Value>> evictBatch(int n)
+    {
+        std::vector<std::pair<Key, Value>> drained;
+        drained.reserve(std::min(n, numEntries));
+        while (n-- > 0 && lruIdx != NIL) {
+            const int idx = lruIdx;
+            indexErase(pool[idx].key, hasher(pool[idx].key));
+            drained.emplace_back(std::move(pool[idx].key), std::move(pool[idx].val));
+            freeNode(idx);
+        }
+        return drained;
+    }
+
+    // Cheap enough to scrape every few seconds: three relaxed loads plus
+    // the map size. Counters read zero when stats are compiled out.
+    LRUCacheStats snapshot() const
+    {
+        LRUCacheStats stats;
+#if LRU_CACHE_STATS
+        stats.hits = hitCount.load(std::memory_order_relaxed);
+        stats.misses = missCount.load(std::memory_order_relaxed);
+        stats.evictions = evictionCount.load(std::memory_order_relaxed);
+#endif
+        stats.occupancy = static_cast<size_t>(numEntries);
+        stats.capacity = static_cast<size_t>(capacity);
+        return stats;
+    }
+
+    // Compact binary snapshot for warm starts after a deploy. Entries
+    // stream out coldest first, so replaying them through put() on load
+    // rebuilds the exact recency order. Keys and values are written as
+    // raw bytes, which confines the format to trivially copyable types -
+    // string-keyed caches need their own serializer. TTLs are stored as
+    // remaining time, since steady_clock points mean nothing across
+    // processes; entries already dead at save time are not written, and
+    // ones that die while the snapshot sits on disk are dropped on load.
+    static constexpr uint32_t SNAPSHOT_MAGIC = 0x4355524c; // "LRUC"
+
+    void saveTo(const std::string& path) const
+    {
+        static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>,
+                      "binary snapshot requires trivially copyable keys and values");
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) throw std::runtime_error("cannot create " + path);
+        const auto now = Clock::now();
+        // Already-expired entries are filtered out here rather than on
+        // load: writing them would only waste bytes, and an entry that
+        // expired exactly one tick before the save would serialize its
+        // remaining time as -1 and collide with the never-expires
+        // sentinel, coming back immortal. Skipping them keeps the stored
+        // remainingNanos strictly positive for every TTL'd entry.
+        uint32_t liveEntries = 0;
+        for (int idx = lruIdx; idx != NIL; idx = pool[idx].next) {
+            if (!expired(pool[idx], now)) ++liveEntries;
+        }
+        const uint32_t header[5] = {SNAPSHOT_MAGIC, 1u, liveEntries,
+                                    static_cast<uint32_t>(sizeof(Key)),
+                                    static_cast<uint32_t>(sizeof(Value))};
+        std::fwrite(header, sizeof(header), 1, file);
+        for (int idx = lruIdx; idx != NIL; idx = pool[idx].next) {
+            if (expired(pool[idx], now)) continue;
+            std::fwrite(&pool[idx].key, sizeof(Key), 1, file);
+            std::fwrite(&pool[idx].val, sizeof(Value), 1, file);
+            int64_t remainingNanos = -1; // -1: never expires
+            if (pool[idx].expiresAt != Clock::time_point::max()) {
+                remainingNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    pool[idx].expiresAt - now).count();
+            }
+            std::fwrite(&remainingNanos, sizeof(remainingNanos), 1, file);
+        }
+        const bool failed = std::ferror(file) != 0;
+        if (std::fclose(file) != 0 || failed) throw std::runtime_error("short write to " + path);
+    }
+
+    void loadFrom(const std::string& path)
+    {
+        static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>,
+                      "binary snapshot requires trivially copyable keys and values");
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) throw std::runtime_error("cannot open " + path);
+        uint32_t header[5];
+        if (std::fread(header, sizeof(header), 1, file) != 1 ||
+            header[0] != SNAPSHOT_MAGIC || header[1] != 1u ||
+            header[3] != sizeof(Key) || header[4] != sizeof(Value)) {
+            std::fclose(file);
+            throw std::runtime_error(path + " is not a snapshot for this cache type");
+        }
+        for (uint32_t i = 0; i < header[2]; ++i) {
+            Key key;
+            Value val;
+            int64_t remainingNanos;
+            if (std::fread(&key, sizeof(Key), 1, file) != 1 ||
+                std::fread(&val, sizeof(Value), 1, file) != 1 ||
+                std::fread(&remainingNanos, sizeof(remainingNanos), 1, file) != 1) {
+                std::fclose(file);
+                throw std::runtime_error(path + " is truncated");
+            }
+            if (remainingNanos == -1) {
+                put(std::move(key), std::move(val));
+            } else if (remainingNanos > 0) {
+                put(std::move(key), std::move(val), std::chrono::duration_cast<Clock::duration>(
+                                              std::chrono::nanoseconds(remainingNanos)));
+            } // else: expired while the snapshot sat on disk
+        }
+        std::fclose(file);
+    }
+};
+
+// Transparent hash for string keys: lets get()/put() probe with a
+// string_view (or char literal) without building a std::string first.
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view sv) const { return std::hash<std::string_view>{}(sv); }
+};
+
+/**
+ * Thread-safe cache built from N independent LRUCache shards, selected by
+ * key hash. Each shard has its own mutex, so threads touching different
+ * shards never contend; total capacity is split across the shards.
+ * Eviction stays LRU within each shard.
+ */
+class ShardedLRUCache {
+    struct Shard {
+        Shard(int cap) : cache(cap) {}
+        std::mutex lock;
+        LRUCache<int, int> cache;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& shardFor(int key) {
+        return *shards[std::hash<int>{}(key) % shards.size()];
+    }
+
+public:
+    ShardedLRUCache(int capacity, int numShards) : shards()
+    {
+        int perShard = std::max(1, capacity / numShards);
+        for (int i = 0; i < numShards; ++i) {
+            shards.push_back(std::make_unique<Shard>(perShard));
+        }
+    }
+
+    int get(int key)
+    {
+        Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        // Copy out under the lock - a pointer into the shard would dangle
+        // once another thread mutates it.
+        int* val = s.cache.get(key);
+        return val ? *val : -1;
+    }
+
+    void put(int key, int value)
+    {
+        Shard& s = shardFor(key);
+        std::lock_guard<std::mutex> guard(s.lock);
+        s.cache.put(key, value);
+    }
+};
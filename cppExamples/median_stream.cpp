@@ -1,63 +1,5 @@
-#include <iostream>
-#include <vector>
-#include <queue>
-#include <cassert>
-using namespace std;
-/**
- * Task: Given a stream of integers, calculate the median at any time.
- * Requirements: 
- *   - addNum(int num): O(log N)
- *   - findMedian(): O(1)
- */
-class MedianFinder {
-    priority_queue<int> heapMax; // holds the smallers
-    priority_queue<int ,vector<int> , greater<int> > heapMin; // hold the largers
-public:
-    void addNum(int num) 
-    {
-        if(!heapMax.empty() and heapMax.top() >= num)
-        {
-            heapMax.push(num);            
-        }
-        else
-        {
-            heapMin.push(num);
-        }
-
-        if(heapMax.size() > heapMin.size())
-        {
-            if(heapMax.size() - heapMin.size() > 1)
-            {
-                int toMove = heapMax.top();
-                heapMax.pop();
-                heapMin.push(toMove);
-            }
-        }
-        else if(heapMax.size() < heapMin.size())
-        {
-            if(heapMin.size() - heapMax.size() > 1)
-            {
-                int toMove = heapMin.top();
-                heapMin.pop();
-                heapMax.push(toMove);
-            }
-        }
-    }
-    
-    double findMedian() 
-    {
-        if(heapMax.size() > heapMin.size())
-        {
-            return heapMax.top();
-        }
-        else if(heapMax.size() < heapMin.size())
-        {
-            return heapMin.top();
-        }
-
-        return (heapMax.top() +  heapMin.top()) / 2.0;
-    }
-};
+#include "median_stream.h"
+using namespace std; // test driver only - the header stays clean
 
 void test_median() {
     MedianFinder mf;
@@ -72,7 +14,146 @@ void test_median() {
     std::cout << "MedianFinder basic tests passed!\n";
 }
 
+void test_batched_median() {
+    // Batches interleaved with single inserts must agree with a finder fed
+    // one element at a time.
+    MedianFinder batched(600);
+    MedianFinder reference;
+    vector<int> chunk;
+
+    unsigned state = 7;
+    for (int round = 0; round < 5; ++round) {
+        chunk.clear();
+        for (int i = 0; i < 100; ++i) {
+            state = state * 1664525 + 1013904223;
+            chunk.push_back(static_cast<int>(state % 500));
+            reference.addNum(chunk.back());
+        }
+        batched.addBatch(chunk);
+        assert(batched.findMedian() == reference.findMedian());
+
+        batched.addNum(static_cast<int>(round));
+        reference.addNum(static_cast<int>(round));
+        assert(batched.findMedian() == reference.findMedian());
+    }
+
+    std::cout << "MedianFinder batched tests passed!\n";
+}
+
+void test_mergeable_median() {
+    // Split one stream across two finders (as per-thread workers would),
+    // merge, and compare with a single finder that saw everything.
+    MedianFinder combined;
+    MedianFinder workerA;
+    MedianFinder workerB;
+
+    unsigned state = 99;
+    for (int i = 0; i < 301; ++i) {
+        state = state * 1664525 + 1013904223;
+        int num = static_cast<int>(state % 1000);
+        combined.addNum(num);
+        (i % 4 == 0 ? workerA : workerB).addNum(num); // uneven split
+    }
+
+    workerB.merge(move(workerA)); // smaller side merged into larger
+    assert(workerA.size() == 0);
+    assert(workerB.size() == combined.size());
+    assert(workerB.findMedian() == combined.findMedian());
+
+    // Merging into an empty finder adopts the other side wholesale.
+    MedianFinder empty;
+    empty.merge(move(workerB));
+    assert(empty.findMedian() == combined.findMedian());
+
+    std::cout << "MedianFinder merge tests passed!\n";
+}
+
+void test_quantile_finder() {
+    QuantileFinder qf({0.5, 0.95, 0.99});
+    vector<int> samples;
+
+    // Deterministic pseudo-random stream; checked against nearest-rank
+    // brute force at every step.
+    unsigned state = 42;
+    for (int i = 0; i < 500; ++i) {
+        state = state * 1664525 + 1013904223;
+        int num = static_cast<int>(state % 1000);
+        qf.addNum(num);
+        samples.push_back(num);
+
+        vector<int> sorted = samples;
+        sort(sorted.begin(), sorted.end());
+        for (double q : {0.5, 0.95, 0.99}) {
+            size_t rank = min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()));
+            assert(qf.quantile(q) == sorted[rank]);
+        }
+    }
+    assert(qf.count() == 500);
+
+    std::cout << "QuantileFinder p50/p95/p99 tests passed!\n";
+}
+
+void test_sliding_median() {
+    const vector<int> stream = {5, 2, 9, 2, 7, 7, 1, 8, 3, 6, 2, 9, 4, 4, 0};
+    const size_t windowSize = 5;
+    SlidingMedianFinder smf(windowSize);
+
+    for (size_t i = 0; i < stream.size(); ++i) {
+        smf.addNum(stream[i]);
+
+        // Brute-force reference: sort the samples currently in the window.
+        size_t begin = (i + 1 > windowSize) ? i + 1 - windowSize : 0;
+        vector<int> window(stream.begin() + begin, stream.begin() + i + 1);
+        sort(window.begin(), window.end());
+        double expected = (window.size() % 2 == 1)
+            ? window[window.size() / 2]
+            : (window[window.size() / 2 - 1] + window[window.size() / 2]) / 2.0;
+
+        assert(smf.findMedian() == expected);
+    }
+
+    std::cout << "SlidingMedianFinder window tests passed!\n";
+}
+
+void test_approx_median() {
+    // The histogram answer must land within one bucket width of the exact
+    // two-heap answer, whatever the input distribution looks like.
+    const size_t bucketCount = 200;
+    const double lo = 0.0, hi = 1000.0;
+    const double bucketWidth = (hi - lo) / bucketCount;
+
+    ApproxMedianFinder approx(bucketCount, lo, hi);
+    MedianFinder exact;
+    unsigned seed = 1234;
+    for (int i = 0; i < 5000; ++i) {
+        seed = seed * 1103515245 + 12345; // same LCG as the quantile test
+        const int sample = static_cast<int>((seed >> 16) % 1000);
+        approx.addNum(sample);
+        exact.addNum(sample);
+        if (i > 0 && i % 500 == 0) {
+            assert(abs(approx.findMedian() - exact.findMedian()) <= bucketWidth);
+        }
+    }
+    assert(approx.count() == 5000);
+
+    // Samples outside the configured range clamp into the edge buckets
+    // instead of being lost.
+    ApproxMedianFinder clamped(10, 0.0, 100.0);
+    clamped.addNum(-50.0);
+    clamped.addNum(1e9);
+    clamped.addNum(1e9);
+    assert(clamped.count() == 3);
+    assert(clamped.findMedian() > 90.0); // majority sits in the top bucket
+
+    std::cout << "ApproxMedianFinder histogram tests passed!\n";
+}
+
 int main() {
     test_median();
+    test_batched_median();
+    test_mergeable_median();
+    test_sliding_median();
+    test_quantile_finder();
+    test_approx_median();
     return 0;
 }
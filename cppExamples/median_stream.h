@@ -0,0 +1,421 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+/**
+ * Task: Given a stream of integers, calculate the median at any time.
+ * Requirements: 
+ *   - addNum(int num): O(log N)
+ *   - findMedian(): O(1)
+ */
+class MedianFinder {
+    // Flat heaps: plain vectors managed with std::push_heap/pop_heap
+    // instead of priority_queue, so we control reserve() up front and can
+    // rebuild in bulk with make_heap after a batch insert.
+    std::vector<int> heapMax; // holds the smallers (max at front)
+    std::vector<int> heapMin; // holds the largers (min at front)
+
+    void pushMax(int num)
+    {
+        heapMax.push_back(num);
+        std::push_heap(heapMax.begin(), heapMax.end());
+    }
+
+    int popMax()
+    {
+        std::pop_heap(heapMax.begin(), heapMax.end());
+        int top = heapMax.back();
+        heapMax.pop_back();
+        return top;
+    }
+
+    void pushMin(int num)
+    {
+        heapMin.push_back(num);
+        std::push_heap(heapMin.begin(), heapMin.end(), std::greater<int>());
+    }
+
+    int popMin()
+    {
+        std::pop_heap(heapMin.begin(), heapMin.end(), std::greater<int>());
+        int top = heapMin.back();
+        heapMin.pop_back();
+        return top;
+    }
+
+    // Restore |heapMax| == |heapMin| or |heapMax| == |heapMin| + 1.
+    void rebalance()
+    {
+        while(heapMax.size() > heapMin.size() + 1)
+        {
+            pushMin(popMax());
+        }
+        while(heapMax.size() < heapMin.size())
+        {
+            pushMax(popMin());
+        }
+    }
+
+public:
+    MedianFinder() = default;
+
+    // Pre-sizes both heaps so a known stream length never reallocates.
+    explicit MedianFinder(size_t expectedCount)
+    {
+        heapMax.reserve(expectedCount / 2 + 1);
+        heapMin.reserve(expectedCount / 2 + 1);
+    }
+
+    void addNum(int num)
+    {
+        if(!heapMax.empty() and heapMax.front() >= num)
+        {
+            pushMax(num);
+        }
+        else
+        {
+            pushMin(num);
+        }
+        rebalance();
+    }
+
+    // Bulk insert: the block is partitioned around the current split point
+    // once, each half is appended and its heap rebuilt with one make_heap
+    // (O(size)), and sizes are rebalanced a single time - instead of a
+    // push_heap + rebalance per element.
+    void addBatch(const int* data, size_t count)
+    {
+        if(count == 0)
+        {
+            return;
+        }
+        const bool haveSplit = !heapMax.empty();
+        const int split = haveSplit ? heapMax.front() : 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(haveSplit and data[i] <= split)
+            {
+                heapMax.push_back(data[i]);
+            }
+            else
+            {
+                heapMin.push_back(data[i]);
+            }
+        }
+        std::make_heap(heapMax.begin(), heapMax.end());
+        std::make_heap(heapMin.begin(), heapMin.end(), std::greater<int>());
+        rebalance();
+    }
+
+    void addBatch(const std::vector<int>& nums)
+    {
+        addBatch(nums.data(), nums.size());
+    }
+
+    size_t size() const
+    {
+        return heapMax.size() + heapMin.size();
+    }
+
+    // Combines another finder into this one, e.g. to reduce per-thread
+    // finders after shared-nothing parallel ingestion. The larger side's
+    // heaps are kept as-is and only the smaller side's elements are pushed
+    // across, so the cost is O(m log N) for m = min(|a|, |b|) rather than
+    // re-inserting everything. 'other' is left empty.
+    void merge(MedianFinder&& other)
+    {
+        if(other.size() > size())
+        {
+            heapMax.swap(other.heapMax);
+            heapMin.swap(other.heapMin);
+        }
+
+        const bool haveSplit = !heapMax.empty();
+        const int split = haveSplit ? heapMax.front() : 0;
+        for(const std::vector<int>* side : {&other.heapMax, &other.heapMin})
+        {
+            for(int num : *side)
+            {
+                if(haveSplit and num <= split)
+                {
+                    pushMax(num);
+                }
+                else
+                {
+                    pushMin(num);
+                }
+            }
+        }
+        other.heapMax.clear();
+        other.heapMin.clear();
+        rebalance();
+    }
+
+    double findMedian()
+    {
+        if(heapMax.size() > heapMin.size())
+        {
+            return heapMax.front();
+        }
+        else if(heapMax.size() < heapMin.size())
+        {
+            return heapMin.front();
+        }
+
+        return (heapMax.front() + heapMin.front()) / 2.0;
+    }
+};
+
+/**
+ * Median over a sliding window of the last W samples: addNum retires the
+ * sample that falls out of the window automatically, so memory is capped
+ * at O(W) instead of growing with the stream.
+ *
+ * Same two-heap layout as MedianFinder, plus lazy deletion: removing a
+ * value only records it in 'delayed' and fixes the live counts; the stale
+ * element is physically popped when it surfaces at a heap top. That keeps
+ * retirement O(log N) amortized and findMedian O(1) on live tops.
+ */
+class SlidingMedianFinder {
+    std::priority_queue<int> heapMax; // holds the smallers
+    std::priority_queue<int ,std::vector<int> , std::greater<int> > heapMin; // holds the largers
+    std::unordered_map<int, int> delayed; // value -> pending removals
+    int maxLive = 0; // live (non-deleted) elements in heapMax
+    int minLive = 0; // live elements in heapMin
+    std::deque<int> window;
+    const size_t windowSize;
+
+    template <typename Heap>
+    void prune(Heap& heap)
+    {
+        while (!heap.empty()) {
+            auto it = delayed.find(heap.top());
+            if (it == delayed.end()) break;
+            if (--(it->second) == 0) delayed.erase(it);
+            heap.pop();
+        }
+    }
+
+    // Invariant: the top of each heap is always a live element, so
+    // comparisons against the tops never see a stale value.
+    void rebalance()
+    {
+        if (maxLive > minLive + 1) {
+            heapMin.push(heapMax.top());
+            heapMax.pop();
+            --maxLive;
+            ++minLive;
+            prune(heapMax); // the uncovered top may be stale
+        } else if (maxLive < minLive) {
+            heapMax.push(heapMin.top());
+            heapMin.pop();
+            --minLive;
+            ++maxLive;
+            prune(heapMin);
+        }
+    }
+
+public:
+    explicit SlidingMedianFinder(size_t _windowSize) : windowSize(_windowSize)
+    {
+    }
+
+    void addNum(int num)
+    {
+        window.push_back(num);
+        if (!heapMax.empty() and heapMax.top() >= num) {
+            heapMax.push(num);
+            ++maxLive;
+        } else {
+            heapMin.push(num);
+            ++minLive;
+        }
+        rebalance();
+
+        if (window.size() > windowSize) {
+            removeNum(window.front());
+            window.pop_front();
+        }
+    }
+
+    void removeNum(int num)
+    {
+        ++delayed[num];
+        // Decide the side before touching the heaps: the partition means
+        // num belongs to heapMax exactly when it is <= its (live) top.
+        if (!heapMax.empty() and num <= heapMax.top()) {
+            --maxLive;
+            if (num == heapMax.top()) prune(heapMax);
+        } else {
+            --minLive;
+            if (!heapMin.empty() and num == heapMin.top()) prune(heapMin);
+        }
+        rebalance();
+    }
+
+    double findMedian()
+    {
+        if (maxLive > minLive) {
+            return heapMax.top();
+        }
+        return (heapMax.top() + heapMin.top()) / 2.0;
+    }
+};
+
+/**
+ * Tracks a configurable set of quantiles (e.g. p50/p95/p99) from a single
+ * pass over the stream. Generalizes the two-heap median idea to k pivots:
+ * the samples are partitioned into k+1 ordered segments, and segment
+ * boundaries are nudged after every insert so that the prefix ending at
+ * segment i always holds exactly rank(q_i)+1 elements. Then quantile q_i
+ * is simply the max of segment i - the same way heapMax.top() is the
+ * median - and each addNum costs O(k log N) instead of running k
+ * independent finders over k copies of the data.
+ *
+ * Quantiles use the nearest-rank definition: value at 0-based index
+ * min(N-1, floor(q*N)) of the sorted stream.
+ */
+class QuantileFinder {
+    std::vector<double> quantiles;   // sorted, each in (0,1)
+    std::vector<std::multiset<int>> segments; // quantiles.size()+1 ordered partitions
+    size_t total = 0;
+
+    // Desired number of elements in segments[0..i] combined.
+    size_t targetPrefix(size_t i) const
+    {
+        size_t rank = std::min(total - 1, static_cast<size_t>(quantiles[i] * total));
+        return rank + 1;
+    }
+
+    // Adjacent segments can be empty, so the donor for a move is the
+    // nearest non-empty segment on the relevant side; the values skipped
+    // over are empty sets, which keeps the partition ordering intact.
+    void moveDown(size_t i) // excess in prefix [0..i]: push its max to segment i+1
+    {
+        size_t from = i;
+        while (segments[from].empty()) --from;
+        auto it = prev(segments[from].end());
+        segments[i + 1].insert(*it);
+        segments[from].erase(it);
+    }
+
+    void moveUp(size_t i) // deficit in prefix [0..i]: pull the next min into segment i
+    {
+        size_t from = i + 1;
+        while (segments[from].empty()) ++from;
+        auto it = segments[from].begin();
+        segments[i].insert(*it);
+        segments[from].erase(it);
+    }
+
+public:
+    explicit QuantileFinder(std::vector<double> _quantiles) : quantiles(std::move(_quantiles))
+    {
+        std::sort(quantiles.begin(), quantiles.end());
+        segments.resize(quantiles.size() + 1);
+    }
+
+    void addNum(int num)
+    {
+        // Insert into the first segment whose max can absorb num.
+        size_t j = 0;
+        while (j < segments.size() - 1 &&
+               (segments[j].empty() || num > *prev(segments[j].end()))) {
+            ++j;
+        }
+        segments[j].insert(num);
+        ++total;
+
+        // One ascending pass restores every prefix target: boundary i only
+        // trades elements with its neighbours, so each needs O(1) moves.
+        size_t prefix = 0;
+        for (size_t i = 0; i < quantiles.size(); ++i) {
+            prefix += segments[i].size();
+            const size_t target = targetPrefix(i);
+            while (prefix > target) { moveDown(i); --prefix; }
+            while (prefix < target) { moveUp(i); ++prefix; }
+        }
+    }
+
+    // q must be one of the quantiles passed to the constructor.
+    double quantile(double q) const
+    {
+        size_t i = 0;
+        while (i < quantiles.size() && quantiles[i] != q) ++i;
+        assert(i < quantiles.size() && "quantile was not configured");
+
+        size_t seg = i;
+        while (segments[seg].empty()) --seg; // target can leave segment i empty
+        return *prev(segments[seg].end());
+    }
+
+    size_t count() const
+    {
+        return total;
+    }
+};
+
+/**
+ * Approximate median for dashboard-grade answers at telemetry rates. The
+ * samples are binned into a fixed array of equal-width buckets over
+ * [lo, hi): addNum is one bounds-clamp and one array increment - O(1),
+ * constant memory, no allocation, branch-predictable - and findMedian is
+ * a single scan over the bucket counts with linear interpolation inside
+ * the bucket that straddles the middle rank. The error is bounded by the
+ * bucket width, which the caller picks via bucketCount and the range.
+ * Out-of-range samples land in the edge buckets, so the median stays
+ * usable (if pessimistic) when the configured bounds are too tight.
+ */
+class ApproxMedianFinder {
+    std::vector<uint64_t> buckets;
+    const double lo;
+    const double width; // per bucket
+    uint64_t total = 0;
+
+public:
+    ApproxMedianFinder(size_t bucketCount, double _lo, double _hi)
+        : buckets(bucketCount, 0), lo(_lo),
+          width((_hi - _lo) / static_cast<double>(bucketCount))
+    {
+        assert(bucketCount > 0 && _lo < _hi);
+    }
+
+    void addNum(double num)
+    {
+        double offset = (num - lo) / width;
+        if (offset < 0) offset = 0;
+        size_t idx = static_cast<size_t>(offset);
+        if (idx >= buckets.size()) idx = buckets.size() - 1;
+        ++buckets[idx];
+        ++total;
+    }
+
+    double findMedian() const
+    {
+        assert(total > 0);
+        // Walk to the bucket holding the middle rank, then interpolate:
+        // ranks are assumed spread evenly across the bucket's width.
+        const double target = static_cast<double>(total) / 2.0;
+        double cumulative = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (cumulative + static_cast<double>(buckets[i]) >= target) {
+                const double intoBucket =
+                    (target - cumulative) / static_cast<double>(buckets[i]);
+                return lo + width * (static_cast<double>(i) + intoBucket);
+            }
+            cumulative += static_cast<double>(buckets[i]);
+        }
+        return lo + width * static_cast<double>(buckets.size()); // all in last bucket
+    }
+
+    size_t count() const
+    {
+        return total;
+    }
+};
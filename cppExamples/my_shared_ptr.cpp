@@ -1,110 +1,32 @@
-#include <iostream>
-#include <cassert>
+#include "my_shared_ptr.h"
 
-// Implement SharedPtr here:
-template<typename T>
-class SharedPtr 
-{
-public:    
-    explicit SharedPtr(T* p)
-    {
-        rawPointer = p;        
-        counter = new size_t(1);
-    }
-
-    SharedPtr(SharedPtr&& other) // move ctor
-    {
-        rawPointer = other.rawPointer;
-        other.rawPointer = nullptr;
-        counter = other.counter;
-        other.counter = nullptr;
-    }
-
-    SharedPtr(const SharedPtr& other) // copy ctor
-    {
-        rawPointer = other.rawPointer;
-        counter = other.counter;
-        ++(*counter);
-    }
-    
-    SharedPtr& operator=(SharedPtr&& other) // move assignment operator
-    {
-        if(this != &other)
-        {
-            --(*(this->counter));
-            if(*(this->counter) == 0)
-            {
-                delete this->rawPointer;
-                delete this->counter;
-            }            
-            rawPointer = other.rawPointer;
-            counter = other.counter;
-            other.rawPointer = nullptr;
-            other.counter = nullptr;            
-        }
-        return *this;
-    }
-
-    SharedPtr& operator=(const SharedPtr& other) // copy assignment operator
-    {
-        if(this != &other)
-        {
-            --(*(this->counter));
-            if(*(this->counter) == 0)
-            {
-                delete this->rawPointer;
-                delete this->counter;
-            }
+struct TestObj {
+    int value;
+    TestObj(int v) : value(v) { std::cout << "TestObj(" << value << ") created\n"; }
+    ~TestObj() { std::cout << "TestObj(" << value << ") destroyed\n"; }
+};
 
-            rawPointer = other.rawPointer;
-            counter = other.counter;
-            ++(*counter);                        
+// Minimal allocator standing in for an arena: counts its traffic so the
+// tests can check both object and control block went through it.
+static int countingAllocations = 0;
+static int countingDeallocations = 0;
 
-        }
-        return *this;
-    }
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template<typename U> CountingAllocator(const CountingAllocator<U>&) {}
 
-    T* operator->() // dereference operator
+    T* allocate(size_t n)
     {
-        return rawPointer;
+        ++countingAllocations;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
     }
-
-    const T& operator*()
+    void deallocate(T* p, size_t)
     {
-        return *rawPointer;
+        ++countingDeallocations;
+        ::operator delete(p);
     }
-
-    ~SharedPtr()
-    {   
-        if( counter and *counter > 0)
-        {
-            --(*counter);
-            if(*counter == 0)
-            {
-                delete rawPointer;
-                rawPointer = nullptr;
-                delete counter;
-                counter = nullptr;
-            }
-        }
-    }
-
-
-    size_t use_count() const
-    {
-        return counter ? *counter : 0;
-    } 
-
-private:
-    size_t* counter;
-    T* rawPointer;
-};
-
-
-struct TestObj {
-    int value;
-    TestObj(int v) : value(v) { std::cout << "TestObj(" << value << ") created\n"; }
-    ~TestObj() { std::cout << "TestObj(" << value << ") destroyed\n"; }
 };
 
 int main() {
@@ -161,6 +83,84 @@ int main() {
         assert(sp2->value == 60);
     }
 
+    std::cout << "\n--- Test 6: MakeShared (single allocation) ---\n";
+    {
+        SharedPtr<TestObj> sp1 = MakeShared<TestObj>(80);
+        assert(sp1.use_count() == 1);
+        assert(sp1->value == 80);
+        {
+            SharedPtr<TestObj> sp2 = sp1;
+            assert(sp2.use_count() == 2);
+        }
+        assert(sp1.use_count() == 1);
+    } // block (object + count) freed together here
+
+    std::cout << "\n--- Test 7: ThreadSafe policy (concurrent copy churn) ---\n";
+    {
+        SharedPtr<TestObj, ThreadSafe> shared = MakeShared<TestObj, ThreadSafe>(90);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&shared]() {
+                // Copy and drop references as fast as possible; with a
+                // non-atomic count this loses increments and double-frees.
+                for (int i = 0; i < 50000; ++i) {
+                    SharedPtr<TestObj, ThreadSafe> local = shared;
+                    assert(local->value == 90);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        assert(shared.use_count() == 1);
+    } // exactly one destruction must happen here
+
+    std::cout << "\n--- Test 8: WeakPtr does not extend lifetime ---\n";
+    {
+        WeakPtr<TestObj> weak;
+        {
+            SharedPtr<TestObj> sp = MakeShared<TestObj>(100);
+            weak = WeakPtr<TestObj>(sp);
+            assert(!weak.expired());
+            assert(sp.use_count() == 1); // weak ref doesn't count
+
+            SharedPtr<TestObj> pinned = weak.lock();
+            assert(pinned.use_count() == 2);
+            assert(pinned->value == 100);
+        } // object destroyed here despite the surviving WeakPtr
+
+        assert(weak.expired());
+        assert(weak.lock().use_count() == 0); // lock after expiry: empty
+    } // block itself freed when the last WeakPtr goes
+
+    std::cout << "\n--- Test 9: Custom deleter ---\n";
+    {
+        int deleterCalls = 0;
+        {
+            SharedPtr<TestObj> sp(new TestObj(110), [&deleterCalls](TestObj* p) {
+                ++deleterCalls;
+                delete p;
+            });
+            SharedPtr<TestObj> sp2 = sp;
+            assert(sp.use_count() == 2);
+        }
+        assert(deleterCalls == 1);
+    }
+
+    std::cout << "\n--- Test 10: AllocateShared (control block from allocator) ---\n";
+    {
+        countingAllocations = 0;
+        countingDeallocations = 0;
+        {
+            SharedPtr<TestObj> sp =
+                AllocateShared<TestObj>(CountingAllocator<TestObj>{}, 120);
+            assert(sp.use_count() == 1);
+            assert(sp->value == 120);
+            assert(countingAllocations == 1); // object + block in one carve
+        }
+        assert(countingDeallocations == 1); // returned through the allocator
+    }
+
     std::cout << "\nAll Tests Passed (if implemented correctly)!\n";
     return 0;
 }
@@ -0,0 +1,402 @@
+#pragma once
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+// Implement SharedPtr here:
+
+// Refcount policies. SingleThreaded (the default) keeps the plain-integer
+// fast path; ThreadSafe uses std::atomic with relaxed increments - a new
+// reference only needs the count to move, not to order memory - and an
+// acquire-release decrement so the destroying thread sees every write made
+// by threads that dropped their references before it.
+struct SingleThreaded
+{
+    using Counter = size_t;
+    static size_t increment(Counter& c) { return ++c; }
+    static size_t decrement(Counter& c) { return --c; }
+    static size_t load(const Counter& c) { return c; }
+    static bool incrementIfNonZero(Counter& c)
+    {
+        if(c == 0) return false;
+        ++c;
+        return true;
+    }
+};
+
+struct ThreadSafe
+{
+    using Counter = std::atomic<size_t>;
+    static size_t increment(Counter& c) { return c.fetch_add(1, std::memory_order_relaxed) + 1; }
+    static size_t decrement(Counter& c) { return c.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+    static size_t load(const Counter& c) { return c.load(std::memory_order_relaxed); }
+    // WeakPtr::lock must not resurrect an object whose last strong
+    // reference is going away: only bump the count if it is still nonzero.
+    static bool incrementIfNonZero(Counter& c)
+    {
+        size_t current = c.load(std::memory_order_relaxed);
+        while(current != 0)
+        {
+            if(c.compare_exchange_weak(current, current + 1, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Control block: the refcount plus a virtual hook describing how to destroy
+// the owned object. Adopting a raw pointer gets a block that deletes it;
+// MakeShared gets a block with the object embedded right next to the count,
+// so one allocation covers both and they share cache locality.
+// Two counts: 'counter' tracks strong references and decides when the
+// object dies; 'weakCounter' tracks weak references plus one share held
+// collectively by all strong references, and decides when the block
+// itself is freed. A WeakPtr therefore keeps the (small) block alive
+// after the object is gone, which is exactly what lets it answer
+// expired()/lock() safely.
+template<typename Policy>
+struct ControlBlockBase
+{
+    typename Policy::Counter counter{1};
+    typename Policy::Counter weakCounter{1};
+    virtual void destroyObject() = 0;
+    // How the block frees itself: plain delete by default, overridden when
+    // the block was carved from a user-supplied allocator/arena.
+    virtual void destroySelf() { delete this; }
+    virtual ~ControlBlockBase() = default;
+};
+
+template<typename T, typename Policy>
+struct PtrControlBlock : ControlBlockBase<Policy>
+{
+    explicit PtrControlBlock(T* p) : ptr(p) {}
+    void destroyObject() override { delete ptr; }
+    T* ptr;
+};
+
+template<typename T, typename Policy>
+struct InplaceControlBlock : ControlBlockBase<Policy>
+{
+    template<typename... Args>
+    explicit InplaceControlBlock(Args&&... args)
+    {
+        ::new(static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+    }
+    void destroyObject() override { object()->~T(); }
+    T* object() { return reinterpret_cast<T*>(storage); }
+    alignas(alignof(T)) unsigned char storage[sizeof(T)];
+};
+
+// Adopts a raw pointer together with a caller-supplied deleter, e.g. a
+// no-op for arena-owned objects or a function returning them to a pool.
+template<typename T, typename Policy, typename Deleter>
+struct DeleterControlBlock : ControlBlockBase<Policy>
+{
+    DeleterControlBlock(T* p, Deleter d) : ptr(p), deleter(std::move(d)) {}
+    void destroyObject() override { deleter(ptr); }
+    T* ptr;
+    Deleter deleter;
+};
+
+// Like InplaceControlBlock, but the block's own memory comes from (a
+// rebound copy of) the user's allocator, so even the control block can
+// live in a request-scoped arena or pool.
+template<typename T, typename Policy, typename Alloc>
+struct AllocatedControlBlock : ControlBlockBase<Policy>
+{
+    using BlockAlloc = typename std::allocator_traits<Alloc>::
+        template rebind_alloc<AllocatedControlBlock>;
+
+    template<typename... Args>
+    explicit AllocatedControlBlock(const Alloc& a, Args&&... args) : alloc(a)
+    {
+        ::new(static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+    }
+    void destroyObject() override { object()->~T(); }
+    void destroySelf() override
+    {
+        BlockAlloc blockAlloc(alloc);
+        this->~AllocatedControlBlock();
+        blockAlloc.deallocate(this, 1);
+    }
+    T* object() { return reinterpret_cast<T*>(storage); }
+    alignas(alignof(T)) unsigned char storage[sizeof(T)];
+    Alloc alloc;
+};
+
+template<typename T, typename Policy = SingleThreaded>
+class SharedPtr
+{
+public:
+    SharedPtr() // empty: what WeakPtr::lock returns after expiry
+    {
+        rawPointer = nullptr;
+        control = nullptr;
+    }
+
+    explicit SharedPtr(T* p)
+    {
+        rawPointer = p;
+        control = new PtrControlBlock<T, Policy>(p);
+    }
+
+    template<typename Deleter>
+    SharedPtr(T* p, Deleter d) // adopt with a custom deleter
+    {
+        rawPointer = p;
+        control = new DeleterControlBlock<T, Policy, Deleter>(p, std::move(d));
+    }
+
+    SharedPtr(SharedPtr&& other) // move ctor
+    {
+        rawPointer = other.rawPointer;
+        other.rawPointer = nullptr;
+        control = other.control;
+        other.control = nullptr;
+    }
+
+    SharedPtr(const SharedPtr& other) // copy ctor
+    {
+        rawPointer = other.rawPointer;
+        control = other.control;
+        if(control)
+        {
+            Policy::increment(control->counter);
+        }
+    }
+
+    SharedPtr& operator=(SharedPtr&& other) // move assignment operator
+    {
+        if(this != &other)
+        {
+            release();
+            rawPointer = other.rawPointer;
+            control = other.control;
+            other.rawPointer = nullptr;
+            other.control = nullptr;
+        }
+        return *this;
+    }
+
+    SharedPtr& operator=(const SharedPtr& other) // copy assignment operator
+    {
+        if(this != &other)
+        {
+            release();
+            rawPointer = other.rawPointer;
+            control = other.control;
+            if(control)
+            {
+                Policy::increment(control->counter);
+            }
+        }
+        return *this;
+    }
+
+    T* operator->() // dereference operator
+    {
+        return rawPointer;
+    }
+
+    const T& operator*()
+    {
+        return *rawPointer;
+    }
+
+    ~SharedPtr()
+    {
+        release();
+        rawPointer = nullptr;
+        control = nullptr;
+    }
+
+
+    size_t use_count() const
+    {
+        return control ? Policy::load(control->counter) : 0;
+    }
+
+private:
+    template<typename U, typename P, typename... Args>
+    friend SharedPtr<U, P> MakeShared(Args&&... args);
+
+    template<typename U, typename P, typename Alloc, typename... Args>
+    friend SharedPtr<U, P> AllocateShared(const Alloc& alloc, Args&&... args);
+
+    template<typename U, typename P>
+    friend class WeakPtr;
+
+    // Adopt an already-built control block (used by MakeShared and
+    // WeakPtr::lock, which have already accounted for the reference).
+    // Block-first argument order keeps this distinct from the public
+    // (pointer, deleter) constructor.
+    SharedPtr(ControlBlockBase<Policy>* block, T* p)
+    {
+        rawPointer = p;
+        control = block;
+    }
+
+    void release()
+    {
+        if(control)
+        {
+            if(Policy::decrement(control->counter) == 0)
+            {
+                control->destroyObject();
+                // Strong refs collectively hold one weak share; dropping it
+                // frees the block once no WeakPtr is left either.
+                if(Policy::decrement(control->weakCounter) == 0)
+                {
+                    control->destroySelf();
+                }
+            }
+        }
+    }
+
+    ControlBlockBase<Policy>* control;
+    T* rawPointer;
+};
+
+// Non-owning companion to SharedPtr: shares the control block but only the
+// weak count, so it never extends the object's lifetime. Caches and back
+// references hold WeakPtr and call lock() to briefly pin the object if it
+// is still alive - breaking the keep-alive cycles a SharedPtr-only
+// registry would create.
+template<typename T, typename Policy = SingleThreaded>
+class WeakPtr
+{
+public:
+    WeakPtr()
+    {
+        rawPointer = nullptr;
+        control = nullptr;
+    }
+
+    WeakPtr(const SharedPtr<T, Policy>& sp)
+    {
+        rawPointer = sp.rawPointer;
+        control = sp.control;
+        if(control)
+        {
+            Policy::increment(control->weakCounter);
+        }
+    }
+
+    WeakPtr(const WeakPtr& other) // copy ctor
+    {
+        rawPointer = other.rawPointer;
+        control = other.control;
+        if(control)
+        {
+            Policy::increment(control->weakCounter);
+        }
+    }
+
+    WeakPtr(WeakPtr&& other) // move ctor
+    {
+        rawPointer = other.rawPointer;
+        other.rawPointer = nullptr;
+        control = other.control;
+        other.control = nullptr;
+    }
+
+    WeakPtr& operator=(const WeakPtr& other) // copy assignment operator
+    {
+        if(this != &other)
+        {
+            releaseWeak();
+            rawPointer = other.rawPointer;
+            control = other.control;
+            if(control)
+            {
+                Policy::increment(control->weakCounter);
+            }
+        }
+        return *this;
+    }
+
+    WeakPtr& operator=(WeakPtr&& other) // move assignment operator
+    {
+        if(this != &other)
+        {
+            releaseWeak();
+            rawPointer = other.rawPointer;
+            control = other.control;
+            other.rawPointer = nullptr;
+            other.control = nullptr;
+        }
+        return *this;
+    }
+
+    ~WeakPtr()
+    {
+        releaseWeak();
+        rawPointer = nullptr;
+        control = nullptr;
+    }
+
+    bool expired() const
+    {
+        return !control or Policy::load(control->counter) == 0;
+    }
+
+    // Pins the object with a new strong reference if it is still alive;
+    // returns an empty SharedPtr otherwise. The conditional increment is
+    // what makes this safe against a concurrent final release.
+    SharedPtr<T, Policy> lock() const
+    {
+        if(control and Policy::incrementIfNonZero(control->counter))
+        {
+            return SharedPtr<T, Policy>(control, rawPointer);
+        }
+        return SharedPtr<T, Policy>();
+    }
+
+    size_t use_count() const
+    {
+        return control ? Policy::load(control->counter) : 0;
+    }
+
+private:
+    void releaseWeak()
+    {
+        if(control)
+        {
+            if(Policy::decrement(control->weakCounter) == 0)
+            {
+                control->destroySelf();
+            }
+        }
+    }
+
+    ControlBlockBase<Policy>* control;
+    T* rawPointer;
+};
+
+// Object and refcount in a single allocation - one allocator round-trip
+// instead of two, and the count sits on the same cache line as the object.
+template<typename T, typename Policy = SingleThreaded, typename... Args>
+SharedPtr<T, Policy> MakeShared(Args&&... args)
+{
+    auto* block = new InplaceControlBlock<T, Policy>(std::forward<Args>(args)...);
+    return SharedPtr<T, Policy>(block, block->object());
+}
+
+// MakeShared, but both the object and the control block come from the
+// caller's allocator - request-scoped arenas and pools included.
+template<typename T, typename Policy = SingleThreaded, typename Alloc, typename... Args>
+SharedPtr<T, Policy> AllocateShared(const Alloc& alloc, Args&&... args)
+{
+    using Block = AllocatedControlBlock<T, Policy, Alloc>;
+    typename Block::BlockAlloc blockAlloc(alloc);
+    Block* block = blockAlloc.allocate(1);
+    ::new(static_cast<void*>(block)) Block(alloc, std::forward<Args>(args)...);
+    return SharedPtr<T, Policy>(block, block->object());
+}
@@ -1,54 +1,85 @@
-#include <iostream>
-#include <mutex>
-#include <thread>
-#include <vector>
-
-/**
- * Task: Implement a thread-safe Singleton class.
- * Requirement: 
- *   - The class should only be instantiable once.
- *   - Getting the instance must be thread-safe.
- */
-class Logger {
-public:
-    static Logger& getInstance() {
-    /*
-    According to c++11 standart:
-    If control enters the declaration concurrently while the variable is being initialized,
-    the concurrent execution shall wait for completion of the initialization.
-    */
-        static Logger instance;
-        return instance;
-    }
-    
-    void log(const std::string& message) const {
-        std::cout << "[LOG]: " << message << std::endl;
-    }
+#include "singleton.h"
 
-    // Delete copy-ctor and assignment to prevent duplicates
-    Logger(const Logger&) = delete;
-    Logger& operator=(const Logger&) = delete;
+// A second shared service, to show one warmup() covering several
+// singletons. Stands in for the config/metrics/thread-pool services that
+// used to each hand-copy the getInstance pattern.
+class Config {
+public:
+    size_t workerCount() const { return 900; }
 
 private:
-    Logger() {
-        std::cout << "Logger initialized." << std::endl;
-    }
+    friend class Singleton<Config>;
+    Config() { std::cout << "Config initialized." << std::endl; }
 };
 
 void thread_task(int id) {
-    // Each thread tries to get the instance and log something
-    Logger::getInstance().log("Thread " + std::to_string(id) + " access");
+    // Each thread tries to get the instance and log something. The typed
+    // front end captures 'id' by value - no string temporaries here.
+    LOG_INFO("Thread {} access", id);
+}
+
+// Would abort if a compiled-out level still evaluated its arguments.
+int mustNotRun() {
+    std::abort();
 }
 
 int main() {
+    // Eagerly construct every registered service up front - both the
+    // "initialized" lines print here, not at some first use mid-run.
+    ServiceRegistry::warmup();
+
+    // Mirror everything into a small mmap-backed binary file; 400 records
+    // per generation forces a couple of rotations over this run.
+    Logger::getInstance().openSink("singleton_log.bin", 400);
+
+    // Exercise both front ends and all capture types once up front.
+    LOG_INFO(std::string("legacy string path"));
+    LOG_INFO("typed: int={} unsigned={} double={} str={}",
+             -7, 42u, 1.5, "literal");
+
+    // Runtime filter: with the threshold at Warn, Info/Debug calls return
+    // before touching the ring; Error always goes through.
+    Logger::getInstance().setMinLevel(Logger::Level::Warn);
+    LOG_DEBUG("suppressed at runtime {}", 1);
+    LOG_INFO("suppressed at runtime too");
+    LOG_ERROR("error passes the Warn threshold");
+    Logger::getInstance().setMinLevel(Logger::Level::Trace);
+
+#if LOG_COMPILE_MIN_LEVEL > LOG_LEVEL_TRACE
+    // When trace is compiled out, this whole call (including the argument
+    // expression) disappears - mustNotRun() is never invoked.
+    LOG_TRACE("never built {}", mustNotRun());
+#endif
+
     std::vector<std::thread> threads;
-    for (int i = 0; i < 900; ++i) {
-        threads.emplace_back(thread_task, i);
+    const size_t workers = Singleton<Config>::instance().workerCount();
+    for (size_t i = 0; i < workers; ++i) {
+        threads.emplace_back(thread_task, static_cast<int>(i));
     }
-    
+
     for (auto& t : threads) {
         t.join();
     }
-    
+
+    // Producers are done; wait for the writer thread to drain the ring so
+    // we can check nothing was lost (Block policy).
+    while (Logger::getInstance().processedCount() < 903) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::cout << "processed=" << Logger::getInstance().processedCount()
+              << " dropped=" << Logger::getInstance().droppedCount() << std::endl;
+
+    // Read the binary sink back: the current generation holds what didn't
+    // fit in the rotated-out file (903 = 2 * 400 + 103).
+    std::cout << "--- sink readback (first 2 records) ---" << std::endl;
+    const size_t current = MappedLogSink::dump("singleton_log.bin", std::cout, 2);
+    const size_t rotated = MappedLogSink::dump("singleton_log.bin.1", std::cout, 0);
+    std::cout << "sink: current=" << current << " rotated=" << rotated << std::endl;
+
+    // Scratch files only - unlink them so a run from the repo root leaves
+    // no artifacts behind (the still-open mapping doesn't mind).
+    std::remove("singleton_log.bin");
+    std::remove("singleton_log.bin.1");
+
     return 0;
 }
@@ -0,0 +1,529 @@
+#pragma once
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Log levels as plain macros so the compile-time minimum below can be
+// compared by the preprocessor (same switch style as LRU_CACHE_STATS in
+// lru_cache.cpp). Logger::Level mirrors these values one-to-one.
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+
+// Calls below this level expand to ((void)0) - the argument expressions
+// are never even parsed into the build, so disabled trace/debug logging
+// costs literally nothing. Override with -DLOG_COMPILE_MIN_LEVEL=N.
+#ifndef LOG_COMPILE_MIN_LEVEL
+#define LOG_COMPILE_MIN_LEVEL LOG_LEVEL_TRACE
+#endif
+
+// Format string wrapper validated at compile time: constructing one from a
+// literal counts the "{}" placeholders in a consteval context and fails the
+// build if the count doesn't match the argument list (same trick as
+// std::format_string). The pointer itself must be a literal / static
+// string, which is also what lets log records store it without copying.
+template <typename... Args>
+struct FmtString {
+    const char* str;
+
+    template <size_t N>
+    consteval FmtString(const char (&s)[N]) : str(s) {
+        size_t placeholders = 0;
+        for (size_t i = 0; i + 1 < N; ++i) {
+            if (s[i] == '{' && s[i + 1] == '}') ++placeholders;
+        }
+        if (placeholders != sizeof...(Args)) {
+            throw "placeholder count does not match argument count";
+        }
+    }
+};
+
+/**
+ * Every service that lives behind Singleton<T> self-registers here, so
+ * warmup() can eagerly construct all of them at startup. Without it each
+ * service pays its construction cost at first touch - an unpredictable
+ * moment mid-request; with it the cost is scheduled where we want it.
+ */
+class ServiceRegistry {
+public:
+    using WarmupFn = void (*)();
+
+    static void add(WarmupFn fn) { fns().push_back(fn); }
+
+    // Construct every registered service now (idempotent: already-built
+    // services are just touched again).
+    static void warmup() {
+        for (WarmupFn fn : fns()) fn();
+    }
+
+private:
+    static std::vector<WarmupFn>& fns() {
+        static std::vector<WarmupFn> list;
+        return list;
+    }
+};
+
+/**
+ * Reusable Meyers singleton. instance() keeps the C++11 guarantee the
+ * hand-written getInstance had: if control enters the declaration
+ * concurrently while the variable is being initialized, the concurrent
+ * execution waits for completion of the initialization. Each used
+ * specialization registers itself with ServiceRegistry before main runs,
+ * so one warmup() call covers every service in the program.
+ */
+template <typename T>
+class Singleton {
+public:
+    static T& instance() {
+        (void)registered; // odr-use: forces registration before main
+        static T object;
+        return object;
+    }
+
+    Singleton() = delete;
+
+private:
+    static bool registerSelf() {
+        ServiceRegistry::add([] { (void)instance(); });
+        return true;
+    }
+    static inline bool registered = registerSelf();
+};
+
+/**
+ * Binary log file backed by mmap. Records have a fixed on-disk layout and
+ * are appended by plain memcpy into the mapping - no write() syscall per
+ * record, the kernel flushes dirty pages on its own and we nudge it with
+ * an asynchronous msync every SYNC_EVERY appends. When the file fills up
+ * it rotates: the current file is renamed to "<path>.1" (replacing the
+ * previous generation) and a fresh mapping starts at <path>. dump() is
+ * the readback side: it renders a file's records as text.
+ */
+class MappedLogSink {
+public:
+    struct FileHeader {
+        char magic[4];        // "SLOG"
+        uint32_t recordCount; // updated after each append
+    };
+
+    struct DiskRecord {
+        uint8_t level;
+        uint8_t pad;
+        uint16_t length;
+        char text[124]; // rendered message, not NUL-terminated
+    };
+    static_assert(sizeof(DiskRecord) == 128, "keep the on-disk layout fixed");
+
+    MappedLogSink(std::string path, size_t maxRecords)
+        : path(std::move(path)), capacity(maxRecords) {
+        mapFresh();
+    }
+
+    ~MappedLogSink() { unmap(/*sync=*/true); }
+
+    MappedLogSink(const MappedLogSink&) = delete;
+    MappedLogSink& operator=(const MappedLogSink&) = delete;
+
+    // Writer-thread only: copy one rendered record into the mapping.
+    void append(uint8_t level, const char* text, size_t length) {
+        if (writeIndex == capacity) rotate();
+        DiskRecord& record = records()[writeIndex];
+        record.level = level;
+        record.pad = 0;
+        record.length = static_cast<uint16_t>(std::min(length, sizeof(record.text)));
+        std::memcpy(record.text, text, record.length);
+        ++writeIndex;
+        header()->recordCount = static_cast<uint32_t>(writeIndex);
+        if (writeIndex % SYNC_EVERY == 0) {
+            msync(base, fileSize(), MS_ASYNC);
+        }
+    }
+
+    // Readback: render up to 'limit' records from a sink file as text.
+    // Returns the total number of records the file holds.
+    static size_t dump(const std::string& path, std::ostream& out, size_t limit) {
+        static const char* const levelNames[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) throw std::runtime_error("cannot open " + path);
+        FileHeader fileHeader{};
+        if (std::fread(&fileHeader, sizeof(fileHeader), 1, file) != 1 ||
+            std::memcmp(fileHeader.magic, "SLOG", 4) != 0) {
+            std::fclose(file);
+            throw std::runtime_error(path + " is not a log sink file");
+        }
+        DiskRecord record{};
+        for (size_t i = 0; i < fileHeader.recordCount && i < limit; ++i) {
+            if (std::fread(&record, sizeof(record), 1, file) != 1) break;
+            out << '[' << (record.level < 5 ? levelNames[record.level] : "?") << "] ";
+            out.write(record.text, record.length);
+            out << '\n';
+        }
+        std::fclose(file);
+        return fileHeader.recordCount;
+    }
+
+private:
+    static constexpr size_t SYNC_EVERY = 64;
+
+    size_t fileSize() const {
+        return sizeof(FileHeader) + capacity * sizeof(DiskRecord);
+    }
+    FileHeader* header() { return static_cast<FileHeader*>(base); }
+    DiskRecord* records() {
+        return reinterpret_cast<DiskRecord*>(static_cast<char*>(base) + sizeof(FileHeader));
+    }
+
+    void mapFresh() {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) throw std::runtime_error("cannot create " + path);
+        if (ftruncate(fd, static_cast<off_t>(fileSize())) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot size " + path);
+        }
+        base = mmap(nullptr, fileSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (base == MAP_FAILED) throw std::runtime_error("cannot map " + path);
+        std::memcpy(header()->magic, "SLOG", 4);
+        header()->recordCount = 0;
+        writeIndex = 0;
+    }
+
+    void unmap(bool sync) {
+        if (base == nullptr) return;
+        if (sync) msync(base, fileSize(), MS_SYNC);
+        munmap(base, fileSize());
+        base = nullptr;
+    }
+
+    void rotate() {
+        unmap(/*sync=*/true);
+        std::rename(path.c_str(), (path + ".1").c_str());
+        mapFresh();
+    }
+
+    std::string path;
+    size_t capacity;
+    void* base = nullptr;
+    size_t writeIndex = 0;
+};
+
+/**
+ * Task: Implement a thread-safe Singleton class.
+ * Requirement:
+ *   - The class should only be instantiable once.
+ *   - Getting the instance must be thread-safe.
+ *
+ * Logging is asynchronous: log() copies the message into a slot of a
+ * bounded lock-free ring (sequence-number MPMC scheme, same idea as
+ * MpmcCyclicQueue in cyclic_queue.cpp) and returns; a dedicated writer
+ * thread drains the ring in batches and pays the stream formatting and
+ * flush cost. Callers never touch the stream lock. When the ring is full
+ * the policy decides: Block spins until space frees up (no message lost),
+ * Drop discards and counts.
+ *
+ * The typed log(fmt, args...) front end allocates nothing on the caller
+ * side: the format literal's pointer and the arguments (integers, floats,
+ * literal C strings) are captured by value into the fixed-size record and
+ * rendered by the writer thread. Placeholder/argument mismatches fail the
+ * build via FmtString.
+ */
+class Logger {
+public:
+    enum class OverflowPolicy { Block, Drop };
+
+    enum class Level : uint8_t {
+        Trace = LOG_LEVEL_TRACE,
+        Debug = LOG_LEVEL_DEBUG,
+        Info  = LOG_LEVEL_INFO,
+        Warn  = LOG_LEVEL_WARN,
+        Error = LOG_LEVEL_ERROR,
+    };
+
+    // Kept as the familiar entry point; the static-local dance itself now
+    // lives in Singleton<T> so every service shares one implementation.
+    static Logger& getInstance() {
+        return Singleton<Logger>::instance();
+    }
+
+    // Legacy front end: copies the already-built string into the record.
+    void log(Level level, const std::string& message) {
+        if (!enabled(level)) return;
+        enqueue([&](Record& record) {
+            record.level = level;
+            record.fmt = nullptr;
+            const size_t len = std::min(message.size(), MAX_MESSAGE - 1);
+            std::memcpy(record.text, message.data(), len);
+            record.text[len] = '\0';
+        });
+    }
+
+    // Structured front end: no temporaries, no allocation - the format
+    // pointer and the argument values go straight into the record and all
+    // string work happens on the writer thread.
+    template <typename... Args>
+    void log(Level level, FmtString<std::type_identity_t<Args>...> fmt, Args... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+        if (!enabled(level)) return;
+        enqueue([&](Record& record) {
+            record.level = level;
+            record.fmt = fmt.str;
+            record.argCount = sizeof...(Args);
+            size_t i = 0;
+            (captureArg(record.args[i++], args), ...);
+        });
+    }
+
+    // Runtime filter: one relaxed load plus an integer compare, done
+    // before any argument capture or formatting work.
+    bool enabled(Level level) const {
+        return static_cast<uint8_t>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    void setMinLevel(Level level) {
+        minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    void setOverflowPolicy(OverflowPolicy p) { policy = p; }
+
+    // Attach a memory-mapped binary sink; the writer thread mirrors every
+    // rendered record into it. Call before logging starts - the logger
+    // owns the sink and closes it (final msync included) at shutdown.
+    void openSink(const std::string& path, size_t maxRecords) {
+        sink = std::make_unique<MappedLogSink>(path, maxRecords);
+        sinkPtr.store(sink.get(), std::memory_order_release);
+    }
+
+    size_t processedCount() const { return processed.load(std::memory_order_acquire); }
+    size_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Delete copy-ctor and assignment to prevent duplicates
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    friend class Singleton<Logger>; // the only thing allowed to construct us
+
+    static constexpr size_t RING_SIZE = 1024; // power of two
+    static constexpr size_t MAX_MESSAGE = 120;
+    static constexpr size_t MAX_ARGS = 4;
+    static constexpr size_t RENDER_BUFFER = 256;
+
+    // One captured argument: a small tagged union, POD all the way.
+    struct LogArg {
+        enum class Type : uint8_t { Int64, UInt64, Double, CStr };
+        Type type;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            const char* s;
+        };
+    };
+
+    struct Record {
+        Level level;
+        const char* fmt; // nullptr marks a legacy raw-text record
+        LogArg args[MAX_ARGS];
+        size_t argCount;
+        char text[MAX_MESSAGE];
+    };
+
+    static const char* levelName(Level level) {
+        switch (level) {
+            case Level::Trace: return "TRACE";
+            case Level::Debug: return "DEBUG";
+            case Level::Info:  return "INFO";
+            case Level::Warn:  return "WARN";
+            case Level::Error: return "ERROR";
+        }
+        return "?";
+    }
+
+    static void captureArg(LogArg& slot, double value) {
+        slot.type = LogArg::Type::Double;
+        slot.d = value;
+    }
+
+    // Lifetime note: only literal / static strings may be logged by
+    // pointer - the record outlives the call site's locals.
+    static void captureArg(LogArg& slot, const char* value) {
+        slot.type = LogArg::Type::CStr;
+        slot.s = value;
+    }
+
+    template <typename Int, typename = std::enable_if_t<std::is_integral_v<Int>>>
+    static void captureArg(LogArg& slot, Int value) {
+        if constexpr (std::is_signed_v<Int>) {
+            slot.type = LogArg::Type::Int64;
+            slot.i = static_cast<int64_t>(value);
+        } else {
+            slot.type = LogArg::Type::UInt64;
+            slot.u = static_cast<uint64_t>(value);
+        }
+    }
+
+    static size_t renderArg(const LogArg& arg, char* out, size_t cap) {
+        int written = 0;
+        switch (arg.type) {
+            case LogArg::Type::Int64:  written = std::snprintf(out, cap, "%lld", static_cast<long long>(arg.i)); break;
+            case LogArg::Type::UInt64: written = std::snprintf(out, cap, "%llu", static_cast<unsigned long long>(arg.u)); break;
+            case LogArg::Type::Double: written = std::snprintf(out, cap, "%g", arg.d); break;
+            case LogArg::Type::CStr:   written = std::snprintf(out, cap, "%s", arg.s); break;
+        }
+        return written < 0 ? 0 : std::min(static_cast<size_t>(written), cap - 1);
+    }
+
+    // Renders into a caller-provided buffer (one pass, shared by the
+    // console and the binary sink). Returns the text length.
+    static size_t renderRecord(const Record& record, char* out, size_t cap) {
+        if (record.fmt == nullptr) {
+            const size_t len = std::min(std::strlen(record.text), cap - 1);
+            std::memcpy(out, record.text, len);
+            return len;
+        }
+        size_t len = 0;
+        size_t nextArg = 0;
+        for (const char* c = record.fmt; *c != '\0' && len + 1 < cap; ++c) {
+            if (c[0] == '{' && c[1] == '}' && nextArg < record.argCount) {
+                len += renderArg(record.args[nextArg++], out + len, cap - len);
+                ++c; // skip the '}'
+            } else {
+                out[len++] = *c;
+            }
+        }
+        return len;
+    }
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+
+    Logger() : slots(new Slot[RING_SIZE]) {
+        for (size_t i = 0; i < RING_SIZE; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writer = std::thread(&Logger::writerLoop, this);
+        std::cout << "Logger initialized." << std::endl;
+    }
+
+    ~Logger() {
+        stopping.store(true, std::memory_order_release);
+        writer.join(); // writer drains whatever is still queued
+        sinkPtr.store(nullptr, std::memory_order_release);
+        sink.reset(); // unmaps and syncs the tail of the file
+        delete[] slots;
+    }
+
+    template <typename FillRecord>
+    void enqueue(FillRecord&& fill) {
+        while (!tryEnqueue(fill)) {
+            if (policy == OverflowPolicy::Drop) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    template <typename FillRecord>
+    bool tryEnqueue(FillRecord&& fill) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & (RING_SIZE - 1)];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            if (seq == pos) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(slot.record);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (seq < pos) {
+                return false; // full
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void writerLoop() {
+        size_t pos = 0; // single consumer: plain local cursor
+        for (;;) {
+            Slot& slot = slots[pos & (RING_SIZE - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) == pos + 1) {
+                char text[RENDER_BUFFER];
+                const size_t len = renderRecord(slot.record, text, sizeof(text));
+                std::cout << "[LOG][" << levelName(slot.record.level) << "]: ";
+                std::cout.write(text, static_cast<std::streamsize>(len));
+                std::cout << '\n';
+                if (MappedLogSink* s = sinkPtr.load(std::memory_order_acquire)) {
+                    s->append(static_cast<uint8_t>(slot.record.level), text, len);
+                }
+                slot.sequence.store(pos + RING_SIZE, std::memory_order_release);
+                ++pos;
+                processed.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+            // Ring drained: flush the batch written so far, then either
+            // exit (if shutting down) or nap until producers catch up.
+            std::cout.flush();
+            if (stopping.load(std::memory_order_acquire) &&
+                slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    Slot* slots;
+    std::unique_ptr<MappedLogSink> sink{};
+    std::atomic<MappedLogSink*> sinkPtr{nullptr};
+    std::atomic<uint8_t> minLevel{LOG_LEVEL_TRACE};
+    alignas(64) std::atomic<size_t> tail{0}; // producers claim slots here
+    std::atomic<size_t> processed{0};
+    std::atomic<size_t> dropped{0};
+    std::atomic<bool> stopping{false};
+    OverflowPolicy policy = OverflowPolicy::Block;
+    std::thread writer;
+};
+
+// Per-level entry points. Levels below LOG_COMPILE_MIN_LEVEL expand to
+// ((void)0), so the call - argument expressions included - never makes it
+// into the translation unit. Levels at or above it still pass through the
+// runtime threshold in Logger::enabled before any capture work happens.
+#if LOG_COMPILE_MIN_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(...) Logger::getInstance().log(Logger::Level::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+#if LOG_COMPILE_MIN_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::getInstance().log(Logger::Level::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+#if LOG_COMPILE_MIN_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::getInstance().log(Logger::Level::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+#if LOG_COMPILE_MIN_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::getInstance().log(Logger::Level::Warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+#define LOG_ERROR(...) Logger::getInstance().log(Logger::Level::Error, __VA_ARGS__)